@@ -0,0 +1,104 @@
+#ifndef JOY_ASSEMBLER__BRANCH_PROFILE_CPP
+#define JOY_ASSEMBLER__BRANCH_PROFILE_CPP
+
+#include "Includes.hpp"
+
+/* Records the outcome of every conditional jump by the address it was
+   executed at (see `ComputationStateDebug::doProfileBranches`), together
+   with how many outcomes two simple predictors kept per site would have
+   predicted correctly: a 1-bit predictor expecting the last outcome and
+   a 2-bit saturating counter, both starting out expecting not taken. */
+class BranchProfile {
+    public:
+        struct Site {
+            uint_t executed{0}, taken{0};
+            uint_t oneBitCorrect{0}, twoBitCorrect{0};
+            bool oneBit{false};
+            /* taken is predicted from 2 on */
+            byte_t twoBit{1};
+        };
+
+    private:
+        std::unordered_map<word_t, Site> sites;
+
+    public: BranchProfile() :
+        sites{}
+    { ; }
+
+    /* Records `instruction`, fetched from `pc`, if it is a conditional
+       jump, given register A. */
+    public: void execute(
+        word_t const pc, Instruction const&instruction, word_t const registerA
+    ) {
+        if (!InstructionNameRepresentationHandler::isConditionalJump(
+            instruction.name))
+            return;
+        bool const isTaken{InstructionNameRepresentationHandler::jumps(
+            instruction.name, registerA)};
+
+        Site &site{sites[pc]};
+        ++site.executed;
+        site.taken += isTaken;
+        site.oneBitCorrect += site.oneBit == isTaken;
+        site.twoBitCorrect += (site.twoBit >= 2) == isTaken;
+        site.oneBit = isTaken;
+        if (isTaken && site.twoBit < 3)
+            ++site.twoBit;
+        if (!isTaken && site.twoBit > 0)
+            --site.twoBit;
+    }
+
+    public: std::map<word_t, Site> getSites() const {
+        return std::map<word_t, Site>{sites.begin(), sites.end()}; }
+
+    /* The `rows` conditional jumps executed most often: how often each was
+       taken and how many of its outcomes either predictor predicted
+       correctly. */
+    public: void report(
+        std::ostream &os, SourceMap const&sourceMap, std::size_t const rows
+    ) const {
+        std::vector<std::tuple<word_t, Site>> sorted{};
+        Site total{};
+        for (auto const&[pc, site] : getSites()) {
+            sorted.emplace_back(pc, site);
+            total.executed += site.executed;
+            total.taken += site.taken;
+            total.oneBitCorrect += site.oneBitCorrect;
+            total.twoBitCorrect += site.twoBitCorrect; }
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](auto const&a, auto const&b) {
+                return std::get<1>(a).executed > std::get<1>(b).executed; });
+
+        std::vector<word_t> addresses{};
+        for (std::size_t j{0}; j < sorted.size() && j < rows; ++j)
+            addresses.push_back(std::get<0>(sorted[j]));
+        std::vector<std::string> const sources{SourceLocations::locate(
+            sourceMap, addresses)};
+
+        os << "branches: " << total.executed << " conditional jumps "
+              "executed at " << sorted.size() << " sites, "
+           << Util::percent(total.taken, total.executed)
+           << " taken; predicted correctly by a 1-bit predictor: "
+           << Util::percent(total.oneBitCorrect, total.executed)
+           << ", by a 2-bit predictor: "
+           << Util::percent(total.twoBitCorrect, total.executed) << "\n"
+           << Util::pad("executed", 12) << Util::pad("taken", 10)
+           << Util::pad("1-bit", 9) << Util::pad("2-bit", 9)
+           << "  location\n";
+        for (std::size_t j{0}; j < sources.size(); ++j) {
+            Site const&site{std::get<1>(sorted[j])};
+            os << Util::pad(std::to_string(site.executed), 12)
+               << Util::pad(Util::percent(site.taken, site.executed), 10)
+               << Util::pad(Util::percent(
+                    site.oneBitCorrect, site.executed), 9)
+               << Util::pad(Util::percent(
+                    site.twoBitCorrect, site.executed), 9)
+               << "  " << sources[j] << "\n";
+        }
+        if (sorted.size() > rows)
+            os << "   (" << sorted.size() - rows << " more sites)\n";
+        os << std::flush;
+    }
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef JOY_ASSEMBLER__CACHE_MODEL_CPP
+#define JOY_ASSEMBLER__CACHE_MODEL_CPP
+
+#include "Includes.hpp"
+
+/* A model of the microarchitecture a program runs on, kept alongside
+   execution: a set-associative instruction cache every fetch goes
+   through, a set-associative data cache every load and store goes
+   through (stack accesses included), each evicting its least recently
+   used line, and a main memory every miss stalls on. Cycles are modeled
+   as each executed instruction's cost -- its micro-instructions unless
+   the configuration says otherwise -- plus the memory latency per miss.
+   A configuration file holds one setting per line; `#` starts a comment:
+
+       instruction-cache <size> <ways> <line size>
+       data-cache <size> <ways> <line size>
+       memory-latency <cycles>
+       cost <instruction> <cycles>
+*/
+class CacheModel {
+    public:
+        struct Geometry {
+            word_t size, ways, lineSize;
+        };
+
+        struct Configuration {
+            Geometry instructionCache{1024, 2, 16};
+            Geometry dataCache{1024, 2, 16};
+            uint_t memoryLatency{20};
+            std::array<uint_t, 256> costs{
+                InstructionNameRepresentationHandler::MicroInstructionsUtil
+                    ::lookupTable};
+        };
+
+        struct Cache {
+            Geometry geometry;
+            /* each set's tags, most recently used first */
+            std::vector<std::vector<word_t>> sets;
+            uint_t hits, misses;
+        };
+
+    private:
+        Configuration configuration;
+        Cache instructionCache, dataCache;
+        uint_t cycles;
+
+    public: CacheModel(Configuration const&configuration) :
+        configuration{configuration},
+        instructionCache{cache(configuration.instructionCache)},
+        dataCache{cache(configuration.dataCache)},
+        cycles{0}
+    { ; }
+
+    /* Accounts for `instruction` fetched from `pc`, given the registers
+       it is executed with. */
+    public: void execute(
+        word_t const pc, Instruction const&instruction,
+        word_t const registerB, word_t const registerSC
+    ) {
+        InstructionName const name{instruction.name};
+        word_t const argument{instruction.argument};
+
+        cycles += configuration.costs[static_cast<byte_t>(name)];
+        access(instructionCache, pc, 5);
+
+        if (InstructionNameRepresentationHandler::doesPointAtData(name))
+            access(dataCache, argument, 4);
+        else if (InstructionNameRepresentationHandler::doesPointAtDataByte(
+            name))
+            access(dataCache, argument, 1);
+        else if (name == InstructionName::LIA || name == InstructionName::SIA)
+            access(dataCache, registerB + argument, 4);
+        else if (name == InstructionName::CAL || name == InstructionName::PSH)
+            access(dataCache, registerSC, 4);
+        else if (name == InstructionName::RET || name == InstructionName::POP)
+            access(dataCache, registerSC - 4, 4);
+        else if (name == InstructionName::LSA || name == InstructionName::SSA)
+            access(dataCache, registerSC + argument, 4);
+    }
+
+    public: uint_t getCycles() const {
+        return cycles; }
+    public: Cache const&getInstructionCache() const {
+        return instructionCache; }
+    public: Cache const&getDataCache() const {
+        return dataCache; }
+
+    public: void report(
+        std::ostream &os, ComputationStateStatistics const&statistics
+    ) const {
+        os << "cache model: " << cycles << " cycles modeled for "
+           << statistics.nInstructions << " instructions ("
+           << statistics.nMicroInstructions << " micro-instructions)\n";
+        auto const line{[&](std::string const&what, Cache const&c) {
+            uint_t const accesses{c.hits + c.misses};
+            os << "    " << what << " (" << c.geometry.size << " bytes, "
+               << c.geometry.ways << "-way, " << c.geometry.lineSize
+               << "-byte lines): " << accesses << " accesses, "
+               << c.hits << " hits (" << Util::percent(c.hits, accesses)
+               << "), " << c.misses << " misses\n"; }};
+        line("instruction cache", instructionCache);
+        line("data cache", dataCache);
+        os << std::flush;
+    }
+
+    public: static Configuration load(std::filesystem::path const&filepath) {
+        std::ifstream is{filepath};
+        if (!is)
+            throw std::runtime_error{"cache model: could not read "
+                + filepath.string()};
+
+        Configuration configuration{};
+        uint_t lineNumber{0};
+        for (std::string ln{}; std::getline(is, ln); ) {
+            ++lineNumber;
+            auto const fail{[&](std::string const&msg) {
+                return std::runtime_error{"cache model: " + filepath.string()
+                    + ":" + std::to_string(lineNumber) + ": " + msg}; }};
+            if (std::size_t const comment{ln.find('#')};
+                comment != std::string::npos)
+                ln.erase(comment);
+
+            std::istringstream tokens{ln};
+            std::vector<std::string> words{
+                std::istream_iterator<std::string>{tokens},
+                std::istream_iterator<std::string>{}};
+            if (words.empty())
+                continue;
+
+            auto const number{[&](std::string const&word) {
+                uint_t n{0};
+                char const*const end{word.data() + word.size()};
+                auto const[ptr, ec]{std::from_chars(word.data(), end, n)};
+                if (ec != std::errc{} || ptr != end
+                    || n > std::numeric_limits<word_t>::max())
+                    throw fail("not a number: " + word);
+                return n; }};
+            auto const geometry{[&]() {
+                if (words.size() != 4)
+                    throw fail("expected size, ways and line size");
+                Geometry const g{static_cast<word_t>(number(words[1])),
+                    static_cast<word_t>(number(words[2])),
+                    static_cast<word_t>(number(words[3]))};
+                if (g.ways == 0 || g.lineSize == 0 || g.size == 0
+                    || g.size % (uint_t{g.ways} * g.lineSize) != 0)
+                    throw fail("the size has to be a non-zero multiple of "
+                        "ways times line size");
+                return g; }};
+
+            if (words[0] == "instruction-cache")
+                configuration.instructionCache = geometry();
+            else if (words[0] == "data-cache")
+                configuration.dataCache = geometry();
+            else if (words[0] == "memory-latency") {
+                if (words.size() != 2)
+                    throw fail("expected a latency");
+                configuration.memoryLatency = number(words[1]); }
+            else if (words[0] == "cost") {
+                if (words.size() != 3)
+                    throw fail("expected an instruction and its cost");
+                std::optional<InstructionName> const oName{
+                    InstructionNameRepresentationHandler::from_string(
+                        words[1])};
+                if (!oName.has_value())
+                    throw fail("unknown instruction: " + words[1]);
+                configuration.costs[static_cast<byte_t>(oName.value())]
+                    = number(words[2]); }
+            else
+                throw fail("unknown setting: " + words[0]);
+        }
+        return configuration; }
+
+    private: static Cache cache(Geometry const&geometry) {
+        return Cache{geometry, std::vector<std::vector<word_t>>(
+            geometry.size / geometry.ways / geometry.lineSize), 0, 0}; }
+
+    /* touches every line the `width` bytes at `address` lie on */
+    private: void access(Cache &c, word_t const address, word_t const width) {
+        uint_t const first{address / c.geometry.lineSize};
+        uint_t const last{(uint_t{address} + width - 1) / c.geometry.lineSize};
+        for (uint_t line{first}; line <= last; ++line) {
+            std::vector<word_t> &set{c.sets[line % c.sets.size()]};
+            word_t const tag{static_cast<word_t>(line / c.sets.size())};
+            auto const it{std::find(set.begin(), set.end(), tag)};
+            if (it != set.end()) {
+                ++c.hits;
+                std::rotate(set.begin(), it, it+1);
+                continue; }
+
+            ++c.misses;
+            cycles += configuration.memoryLatency;
+            if (set.size() < c.geometry.ways)
+                set.insert(set.begin(), tag);
+            else {
+                std::rotate(set.begin(), set.end()-1, set.end());
+                set.front() = tag; }
+        }
+    }
+};
+
+#endif
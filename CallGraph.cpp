@@ -0,0 +1,150 @@
+#ifndef JOY_ASSEMBLER__CALL_GRAPH_CPP
+#define JOY_ASSEMBLER__CALL_GRAPH_CPP
+
+#include "Includes.hpp"
+
+/* Attributes executed instructions to the call paths they were executed
+   on, following `CAL` and `RET` on a shadow call stack (see
+   `ComputationStateDebug::doProfileCalls`). A path is a chain of frames,
+   each one a function entered at the address a `CAL` jumped to, rooted at
+   the address the program started at; `CAL` itself is attributed to its
+   caller and `RET` to the function it returns from. A `RET` on an empty
+   shadow stack -- a program managing return addresses itself -- stays
+   in the root frame. */
+class CallGraph {
+    public:
+        struct Frame {
+            word_t function;
+            /* the calling frame; the root is its own parent */
+            std::size_t parent;
+            uint_t calls;
+            /* executed in this frame, excluding callees */
+            ComputationStateStatistics self;
+            std::map<word_t, std::size_t> callees;
+        };
+
+    private:
+        /* callers precede their callees */
+        std::vector<Frame> frames;
+        std::size_t current;
+
+    public: CallGraph() :
+        frames{}, current{0}
+    { ; }
+
+    public: void execute(word_t const pc, Instruction const&instruction) {
+        if (frames.empty())
+            frames.push_back(Frame{pc, 0, 1, {0, 0}, {}});
+
+        Frame &frame{frames[current]};
+        ++frame.self.nInstructions;
+        frame.self.nMicroInstructions += InstructionNameRepresentationHandler
+            ::microInstructions(instruction.name);
+
+        if (instruction.name == InstructionName::CAL) {
+            auto const[it, inserted]{frame.callees.try_emplace(
+                instruction.argument, frames.size())};
+            std::size_t const callee{it->second};
+            if (inserted)
+                frames.push_back(Frame{instruction.argument, current, 0,
+                    {0, 0}, {}});
+            ++frames[callee].calls;
+            current = callee; }
+        else if (instruction.name == InstructionName::RET)
+            current = frames[current].parent;
+    }
+
+    public: std::vector<Frame> const&getFrames() const {
+        return frames; }
+
+    /* One line per call path, its frames separated by `;` and followed by
+       the micro-instructions executed in its last frame, as read by
+       `flamegraph.pl`; functions are named by the nearest label. */
+    public: void writeFolded(
+        std::ostream &os, SourceMap const&sourceMap
+    ) const {
+        std::vector<std::string> paths(frames.size());
+        for (std::size_t j{0}; j < frames.size(); ++j) {
+            Frame const&frame{frames[j]};
+            paths[j] = (j == 0 ? std::string{} : paths[frame.parent] + ";")
+                + sourceMap.symbolize(frame.function);
+            if (frame.self.nMicroInstructions > 0)
+                os << paths[j] << " " << frame.self.nMicroInstructions << "\n";
+        }
+        os << std::flush;
+    }
+
+    /* Every function's calls as well as instructions and micro-instructions
+       executed in it (exclusive) and in it or its callees (inclusive), by
+       inclusive micro-instructions. A recursive function's inclusive count
+       includes its recursion only once. */
+    public: void report(std::ostream &os, SourceMap const&sourceMap) const {
+        struct Row {
+            uint_t calls{0};
+            ComputationStateStatistics inclusive{0, 0}, exclusive{0, 0};
+        };
+
+        std::vector<ComputationStateStatistics> inclusive(frames.size());
+        for (std::size_t j{frames.size()}; j-- > 0; ) {
+            inclusive[j].nInstructions += frames[j].self.nInstructions;
+            inclusive[j].nMicroInstructions
+                += frames[j].self.nMicroInstructions;
+            if (j > 0) {
+                inclusive[frames[j].parent].nInstructions
+                    += inclusive[j].nInstructions;
+                inclusive[frames[j].parent].nMicroInstructions
+                    += inclusive[j].nMicroInstructions; }
+        }
+
+        /* depth-first, counting how often each function is on the path */
+        std::map<word_t, Row> rows{};
+        std::map<word_t, std::size_t> onPath{};
+        std::vector<std::tuple<std::size_t, bool>> pending{};
+        if (!frames.empty())
+            pending.emplace_back(0, true);
+        while (!pending.empty()) {
+            auto const[j, entering]{pending.back()};
+            pending.pop_back();
+            Frame const&frame{frames[j]};
+            if (!entering) {
+                --onPath[frame.function];
+                continue; }
+
+            Row &row{rows[frame.function]};
+            row.calls += frame.calls;
+            row.exclusive.nInstructions += frame.self.nInstructions;
+            row.exclusive.nMicroInstructions += frame.self.nMicroInstructions;
+            if (onPath[frame.function]++ == 0) {
+                row.inclusive.nInstructions += inclusive[j].nInstructions;
+                row.inclusive.nMicroInstructions
+                    += inclusive[j].nMicroInstructions; }
+
+            pending.emplace_back(j, false);
+            for (auto const&[_, callee] : frame.callees)
+                pending.emplace_back(callee, true);
+        }
+
+        std::vector<std::tuple<word_t, Row>> sorted{rows.begin(), rows.end()};
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](auto const&a, auto const&b) {
+                return std::get<1>(a).inclusive.nMicroInstructions
+                    > std::get<1>(b).inclusive.nMicroInstructions; });
+
+        os << "call graph: " << frames.size() << " call paths through "
+           << rows.size() << " functions\n"
+           << "       calls   inclusive (micro-instr.)   exclusive "
+              "(micro-instr.)  function\n";
+        for (auto const&[function, row] : sorted)
+            os << Util::pad(std::to_string(row.calls), 12)
+               << Util::pad(std::to_string(row.inclusive.nInstructions), 12)
+               << Util::pad("(" + std::to_string(
+                   row.inclusive.nMicroInstructions) + ")", 15)
+               << Util::pad(std::to_string(row.exclusive.nInstructions), 12)
+               << Util::pad("(" + std::to_string(
+                   row.exclusive.nMicroInstructions) + ")", 15)
+               << "  " << sourceMap.symbolize(function) << "\n";
+        os << std::flush;
+    }
+};
+
+#endif
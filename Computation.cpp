@@ -5,9 +5,13 @@
 
 class ComputationState {
     friend class Parser;
+    friend class CppTranslator;
+    friend class ObjectFile;
+    friend class Linker;
+    friend class Optimizer;
 
     private:
-        std::vector<byte_t> memory;
+        Memory memory;
         bool const memoryIsDynamic;
         MemoryMode const memoryMode;
         word_t registerA, registerB, registerPC, registerSC;
@@ -16,12 +20,57 @@ class ComputationState {
 
         std::vector<std::vector<std::tuple<bool, std::string>>> const profiler;
         ComputationStateStatistics statistics;
-        std::stack<ComputationStateStatistics> profilerStatistics;
         bool embedProfilerOutput;
-        std::optional<std::vector<MemorySemantic>> oMemorySemantics;
+
+        /* The profiler directives by the address they are triggered at,
+           each start naming the region it opens. `profilerHooks` marks
+           those addresses, such that a step anywhere else costs a single
+           bit test; started regions are stacked until they are stopped. */
+        struct ProfilerHook {
+            bool doStart;
+            std::string message;
+            std::size_t region;
+        };
+        std::vector<bool> profilerHooks;
+        std::unordered_map<word_t, std::vector<ProfilerHook>> profilerTable;
+        std::vector<ProfilerRegion> profilerRegions;
+        std::stack<std::tuple<ComputationStateStatistics, std::size_t>>
+            profilerStarts;
+
+        /* statistics by the address instructions were executed at, kept
+           when `debug.doCountExecutions`; far out addresses are kept
+           apart, such that large memories do not blow up the vector */
+        std::vector<ComputationStateStatistics> pcStatistics;
+        std::map<word_t, ComputationStateStatistics> farPCStatistics;
+        /* kept when `debug.doProfileCalls` */
+        CallGraph calls;
+        /* kept when `debug.doProfileBranches` */
+        BranchProfile branches;
+        std::optional<CacheModel> oCacheModel;
+
+        /* decoded instructions, keyed by program counter and grown a page
+           at a time to the highest one fetched from; an entry is
+           invalidated as soon as any of its five bytes is overwritten */
+        DecodedInstructions decodedInstructions;
+        static word_t constexpr sparseDecodeLimit{1 << 24};
+        JIT::Cache jit;
+
+        /* whether `verify` ran since the last instruction was stored; if
+           it bounded the stack depth (see `StackAnalysis`), the bound and
+           whether it lies within the declared stack */
+        bool verified;
+        std::optional<uint_t> oStackDepth;
+        bool stackProven;
+
+        /* where a guarded access which faulted is re-executed from */
+        word_t trapPC, trapSC;
+
+        std::unique_ptr<MachineIO::Sink> output;
+        std::unique_ptr<MachineIO::Source> input;
 
         bool mock;
         mutable bool ok;
+        std::string faultMessage;
     public:
         ComputationStateDebug debug;
 
@@ -32,9 +81,9 @@ class ComputationState {
         Util::rng_t const&rng,
         std::vector<std::vector<std::tuple<bool, std::string>>> const&profiler,
         bool const embedProfilerOutput,
-        std::optional<std::vector<MemorySemantic>> const&oMemorySemantics
+        std::optional<SemanticMap> oMemorySemantics
     ) :
-        memory{std::vector<byte_t>(memorySize, 0x00000000)},
+        memory{memorySize, memoryIsDynamic, std::move(oMemorySemantics)},
         memoryIsDynamic{memoryIsDynamic},
         memoryMode{memoryMode},
         registerA{0}, registerB{0}, registerPC{0}, registerSC{0},
@@ -42,14 +91,33 @@ class ComputationState {
 
         rng{rng},
 
-        profiler{profiler}, statistics{0, 0}, profilerStatistics{},
+        profiler{profiler}, statistics{0, 0},
         embedProfilerOutput{embedProfilerOutput},
-        oMemorySemantics{oMemorySemantics},
+        profilerHooks(profiler.size()), profilerTable{}, profilerRegions{},
+        profilerStarts{},
+        pcStatistics{}, farPCStatistics{}, calls{}, branches{},
+        oCacheModel{std::nullopt},
+        decodedInstructions{},
+        jit{},
+        verified{false}, oStackDepth{std::nullopt}, stackProven{false},
+
+        trapPC{0}, trapSC{0},
 
-        mock{false}, ok{true},
+        output{std::make_unique<MachineIO::StreamSink>(
+            std::cout, MachineIO::FlushPolicy::Input)},
+        input{std::make_unique<MachineIO::ConsoleSource>(std::cin)},
+
+        mock{false}, ok{true}, faultMessage{},
 
         debug{}
     {
+        for (std::size_t m{0}; m < profiler.size(); ++m)
+            for (auto const&[doStart, msg] : profiler[m]) {
+                profilerHooks[m] = true;
+                profilerTable[static_cast<word_t>(m)].push_back(
+                    ProfilerHook{doStart, msg, profilerRegions.size()});
+                if (doStart)
+                    profilerRegions.push_back(ProfilerRegion{msg}); }
         updateFlags(); }
 
     /* since ComputationState::memory may be rather large, all copy
@@ -86,9 +154,8 @@ class ComputationState {
                     print(" --");
                     continue; }
 
-                if (oMemorySemantics.has_value()) {
-                    std::vector<MemorySemantic> const memorySemantics{
-                        oMemorySemantics.value()};
+                if (memory.hasSemantics()) {
+                    SemanticMap const&memorySemantics{memory.semantics()};
                     if (m < memorySemantics.size())
                         print(Util::ANSI_COLORS
                             ::memorySemanticColor(memorySemantics[m])); }
@@ -112,7 +179,7 @@ class ComputationState {
                     print(Util::ANSI_COLORS::MEMORY_LOCATION_USED);
 
 
-                print(" " + Util::UInt8AsPaddedHex(memory[y *w+ x]));
+                print(" " + Util::UInt8AsPaddedHex(memory.read(y *w+ x)));
                 print(Util::ANSI_COLORS::CLEAR);
                 ++pc;
             }
@@ -171,48 +238,50 @@ class ComputationState {
 
         // do not print unnecessary zeros
         if (!memory.empty()) {
-            word_t mx{static_cast<word_t>(memory.size()-1)};
-            while (mx > 0 && memory[mx] == 0)
-                --mx;
-            for (byte_t const b : memory) {
-                std::cout << " " + Util::UInt8AsPaddedHex(b);
-                if (mx-- <= 0)
-                    break;
-            }
+            std::size_t const mx{memory.lastNonZero()};
+            for (std::size_t m{0}; m <= mx; ++m)
+                std::cout << " " + Util::UInt8AsPaddedHex(memory.read(m));
         }
 
         std::cout << "\n";
     }
 
+    /* Records the regions stopped at the current instruction. Starts and
+       stops are only logged as they are hit if `debug.profilerOutput` asks
+       for it; with `embedProfilerOutput`, every stop rather outputs the
+       micro-instructions elapsed since its start. */
     private: void checkProfiler() {
-        if (profiler.size() <= registerPC)
+        auto const it{profilerTable.find(registerPC)};
+        if (it == profilerTable.end())
             return;
 
+        bool const doLog{!embedProfilerOutput
+            && debug.profilerOutput == ProfilerOutput::Hits};
         auto const prf{[](std::string const&msg) {
             std::clog << msg << std::endl; }};
 
-        for (auto [doStart, msg] : profiler.at(registerPC)) {
+        for (ProfilerHook const&hook : it->second) {
             std::string const str{"[# "
                 + std::to_string(statistics.nInstructions) + ": "
                 + std::to_string(statistics.nMicroInstructions) + "] "};
             std::string const strPad{std::string(str.size(), ' ')};
 
-            if (doStart) {
-                if (!embedProfilerOutput)
-                    prf(str + "starting profiler: " + msg);
-                profilerStatistics.push(statistics);
+            if (hook.doStart) {
+                if (doLog)
+                    prf(str + "starting profiler: " + hook.message);
+                profilerStarts.emplace(statistics, hook.region);
                 continue; }
 
-            if (!embedProfilerOutput)
-                prf(str + "stopping profiler: " + msg);
-            if (profilerStatistics.empty()) {
+            if (doLog)
+                prf(str + "stopping profiler: " + hook.message);
+            if (profilerStarts.empty()) {
                 prf(str + "profiler could not be stopped since it was "
                     "never started");
                 continue; }
 
-            ComputationStateStatistics const start{profilerStatistics.top()};
+            auto const[start, region]{profilerStarts.top()};
             ComputationStateStatistics const stop{statistics};
-            profilerStatistics.pop();
+            profilerStarts.pop();
             if (
                 start.nInstructions > stop.nInstructions
                 || start.nMicroInstructions > stop.nMicroInstructions
@@ -221,55 +290,246 @@ class ComputationState {
                 continue; }
 
             ComputationStateStatistics const elapsed{stop - start};
-            if (!embedProfilerOutput) {
+            profilerRegions[region].record(elapsed);
+            if (doLog)
                 prf(strPad + "-> number of elapsed instructions: "
                     + elapsed.toString());
-                continue; }
+            if (embedProfilerOutput)
+                output->put(std::to_string(elapsed.nMicroInstructions) + "\n");
+        }
+    }
+
+    /* every region started by a profiler directive, in the order of their
+       directives' addresses */
+    public: std::vector<ProfilerRegion> const&getProfilerRegions() const {
+        return profilerRegions; }
+
+    public: bool embedsProfilerOutput() const {
+        return embedProfilerOutput; }
+
+    /* Executes at most `maxInstructions` instructions. Visualization,
+       the profiler and error handling are only paid for when they are
+       active; flags are written back and the output is flushed once when
+       returning. A run stops in front of any profiler directive which is
+       not located at the first executed instruction, reporting a
+       `ProfilerBoundary`. */
+    public: StopReason run(uint_t const maxInstructions) {
+        if (!verified)
+            verify();
+        if (!ok) {
+            if (faultMessage.empty())
+                faultMessage = "erroneous machine state";
+            return StopReason::Fault; }
+
+        StopReason reason{StopReason::BudgetExhausted};
+        try {
+            if (!debug.doVisualizeSteps)
+                reason = runEngine(maxInstructions);
+            else for (uint_t n{0}; n < maxInstructions; ++n) {
+                if (n > 0 && isProfilerBoundary(registerPC)) {
+                    reason = StopReason::ProfilerBoundary;
+                    break; }
 
-            std::cout << std::to_string(elapsed.nMicroInstructions) << "\n";
+                visualize();
+                reason = runEngine(1);
+                updateFlags();
+                output->flush();
+                if (reason != StopReason::BudgetExhausted)
+                    break;
+            }
+        } catch (std::runtime_error const&e) {
+            faultMessage = e.what();
+            reason = StopReason::Fault;
         }
+
+        updateFlags();
+        output->flush();
+
+        if (reason != StopReason::Fault && !ok) {
+            faultMessage = "erroneous machine state";
+            reason = StopReason::Fault; }
+
+        return reason;
     }
 
-    public: bool step() {
-        checkProfiler();
+    public: std::string const&getFaultMessage() const {
+        return faultMessage; }
+
+    /* replace where `PTU`, `PTS`, `PTB` and `PTC` write to and where `GET`
+       and `GTC` read from */
+    public: void setOutput(std::unique_ptr<MachineIO::Sink> sink) {
+        output->flush();
+        output = std::move(sink); }
+    public: void setInput(std::unique_ptr<MachineIO::Source> source) {
+        input = std::move(source); }
+
+    /* Selects the `MemoryPolicy` matching the current configuration and
+       calls `f` with it. Execution engines are entered through this once per
+       run, such that their memory accesses do not branch on configuration
+       which cannot change while running. */
+    private: template<typename F> auto withPolicy(F const&f) {
+        return withPolicy(f, memoryIsDynamic ? MemoryBounds::Dynamic
+            : memory.isGuarded() ? MemoryBounds::Guarded : MemoryBounds::Fixed);
+    }
 
-        Instruction instruction{nextInstruction()};
+    private: template<typename F> auto withPolicy(
+        F const&f, MemoryBounds const bounds
+    ) {
+        auto const select{[](bool const b, auto const&g) {
+            return b ? g(std::true_type{}) : g(std::false_type{}); }};
+        auto const selectBounds{[&](auto const&g) {
+            using B = MemoryBounds;
+            if (bounds == B::Dynamic)
+                return g(std::integral_constant<B, B::Dynamic>{});
+            if (bounds == B::Guarded)
+                return g(std::integral_constant<B, B::Guarded>{});
+            return g(std::integral_constant<B, B::Fixed>{}); }};
+
+        /* only static programs can have their stack proven */
+        auto const selectStack{[&](auto semantics, auto const&g) {
+            if constexpr (decltype(semantics)::value)
+                return select(!stackProven, g);
+            else
+                return g(std::true_type{}); }};
+
+        return select(memoryMode == MemoryMode::BigEndian, [&](auto bigEndian) {
+        return selectBounds([&](auto bounds_) {
+        return select(memory.hasSemantics(), [&](auto semantics) {
+        return selectStack(semantics, [&](auto stack) {
+        return select(mock, [&](auto mock_) {
+            return f(MemoryPolicy<decltype(bigEndian)::value
+                    ? MemoryMode::BigEndian : MemoryMode::LittleEndian,
+                decltype(bounds_)::value, decltype(semantics)::value,
+                decltype(stack)::value, decltype(mock_)::value>{});
+        }); }); }); }); });
+    }
 
-        ++statistics.nInstructions;
-        statistics.nMicroInstructions += InstructionNameRepresentationHandler
-            ::microInstructions(instruction.name);
+    /* Moves the memory into a guarded reservation (see `Memory::guard`),
+       leaving bounds checks to the hardware. Dynamic memory cannot be
+       guarded, nor can memory reaching the top of the address space, where
+       word accesses would wrap around. */
+    public: bool guardMemory() {
+        if (memoryIsDynamic || memory.size() > 0xfffffffd)
+            return false;
+        return memory.guard(); }
+
+    private: StopReason runEngine(uint_t const maxInstructions) {
+#ifdef JOY_ASSEMBLER__GUARDED_MEMORY_AVAILABLE
+        if (memory.isGuarded()) {
+            sigjmp_buf trap;
+            if (sigsetjmp(trap, 0) != 0) {
+                /* A guarded access faulted. Executing the faulting
+                   instruction once more with explicit bounds checks reports
+                   the precise error. */
+                MemoryGuard::disarm();
+                registerPC = trapPC;
+                registerSC = trapSC;
+                withPolicy([&](auto policy) {
+                    using Policy = decltype(policy);
+                    execute<Policy>(nextInstruction<Policy>()); },
+                    MemoryBounds::Fixed);
+                throw std::runtime_error{"memory access violation"};
+            }
 
+            MemoryGuard::arm(trap, memory.guardedBegin(), memory.guardedEnd());
+            try {
+                StopReason const reason{dispatchEngine(maxInstructions)};
+                MemoryGuard::disarm();
+                return reason;
+            } catch (...) {
+                MemoryGuard::disarm();
+                throw; }
+        }
+#endif
+
+        return dispatchEngine(maxInstructions);
+    }
+
+    private: StopReason dispatchEngine(uint_t const maxInstructions) {
+        return withPolicy([&](auto policy) {
+            using Policy = decltype(policy);
+            switch (debug.engine) {
+                case ExecutionEngine::Switch:
+                    return runSwitch<Policy>(maxInstructions);
+                case ExecutionEngine::Threaded:
+                    return runThreaded<Policy>(maxInstructions);
+                case ExecutionEngine::Native:
+                    return runNative<Policy>(maxInstructions);
+            }
+
+            return StopReason::Fault; });
+    }
+
+    private: template<typename Policy> void setTrap() {
+        if constexpr (Policy::bounds == MemoryBounds::Guarded) {
+            trapPC = registerPC;
+            trapSC = registerSC; } }
+
+    private: bool isProfilerBoundary(word_t const pc) const {
+        return pc < profilerHooks.size() && profilerHooks[pc]; }
+
+    private: template<typename Policy>
+    StopReason runSwitch(uint_t const maxInstructions) {
+        bool const doCheckProfiler{!profilerHooks.empty()};
+        bool const doObserve{observing()};
+
+        for (uint_t n{0}; n < maxInstructions; ++n) {
+            if (doCheckProfiler && isProfilerBoundary(registerPC)) {
+                if (n > 0)
+                    return StopReason::ProfilerBoundary;
+                checkProfiler(); }
+
+            setTrap<Policy>();
+            Instruction const instruction{nextInstruction<Policy>()};
+
+            ++statistics.nInstructions;
+            statistics.nMicroInstructions += InstructionNameRepresentationHandler
+                ::microInstructions(instruction.name);
+            if (doObserve)
+                observe(registerPC - 5, instruction);
+
+            if (!execute<Policy>(instruction))
+                return StopReason::Halted;
+        }
+
+        return StopReason::BudgetExhausted;
+    }
+
+    /* Executes a single fetched instruction, returning `false` iff it
+       halts the machine. Flags are not updated; since they are a function
+       of register A, jumps test A directly. */
+    private: template<typename Policy>
+    bool execute(Instruction const&instruction) {
         auto jmp = [&](bool const cnd) {
             if (cnd)
                 registerPC = instruction.argument; };
+        auto const jumps{[&](InstructionName const name) {
+            return InstructionNameRepresentationHandler::jumps(
+                name, registerA); }};
 
         switch (instruction.name) {
             case InstructionName::NOP:
                 break;
 
             case InstructionName::LDA:
-                registerA = loadMemory4(instruction.argument,
-                    wordMemorySemanticData);
+                registerA = loadData4<Policy>(instruction.argument);
                 break;
             case InstructionName::LDB:
-                registerB = loadMemory4(instruction.argument,
-                    wordMemorySemanticData);
+                registerB = loadData4<Policy>(instruction.argument);
                 break;
             case InstructionName::STA:
-                storeMemory4(instruction.argument, registerA,
-                    wordMemorySemanticData);
+                storeData4<Policy>(instruction.argument, registerA);
                 break;
             case InstructionName::STB:
-                storeMemory4(instruction.argument, registerB,
-                    wordMemorySemanticData);
+                storeData4<Policy>(instruction.argument, registerB);
                 break;
             case InstructionName::LIA:
-                registerA = loadMemory4(registerB + instruction.argument,
-                    wordMemorySemanticData);
+                registerA = loadMemory4<Policy>(
+                    registerB + instruction.argument, wordMemorySemanticData);
                 break;
             case InstructionName::SIA:
-                storeMemory4(registerB + instruction.argument, registerA,
-                    wordMemorySemanticData);
+                storeMemory4<Policy>(registerB + instruction.argument,
+                    registerA, wordMemorySemanticData);
                 break;
             case InstructionName::LPC:
                 registerA = registerPC;
@@ -278,11 +538,11 @@ class ComputationState {
                 registerPC = registerA;
                 break;
             case InstructionName::LYA:
-                registerA = (registerA                        & 0xffffff00)
-                          | (loadMemory(instruction.argument) & 0x000000ff);
+                registerA = (registerA & 0xffffff00)
+                    | (loadData<Policy>(instruction.argument) & 0x000000ff);
                 break;
             case InstructionName::SYA:
-                storeMemory(instruction.argument, static_cast<byte_t>(
+                storeData<Policy>(instruction.argument, static_cast<byte_t>(
                     registerA & 0xff));
                 break;
 
@@ -290,51 +550,53 @@ class ComputationState {
                 jmp(true);
                 break;
             case InstructionName::JN:
-                jmp(flagANegative);
+                jmp(jumps(InstructionName::JN));
                 break;
             case InstructionName::JNN:
-                jmp(!flagANegative);
+                jmp(jumps(InstructionName::JNN));
                 break;
             case InstructionName::JZ:
-                jmp(flagAZero);
+                jmp(jumps(InstructionName::JZ));
                 break;
             case InstructionName::JNZ:
-                jmp(!flagAZero);
+                jmp(jumps(InstructionName::JNZ));
                 break;
             case InstructionName::JP:
-                jmp(!flagANegative && !flagAZero);
+                jmp(jumps(InstructionName::JP));
                 break;
             case InstructionName::JNP:
-                jmp(flagANegative || flagAZero);
+                jmp(jumps(InstructionName::JNP));
                 break;
             case InstructionName::JE:
-                jmp(flagAEven);
+                jmp(jumps(InstructionName::JE));
                 break;
             case InstructionName::JNE:
-                jmp(!flagAEven);
+                jmp(jumps(InstructionName::JNE));
                 break;
 
             case InstructionName::CAL:
-                storeMemory4Stack(registerSC, registerPC);
+                storeMemory4Stack<Policy>(registerSC, registerPC);
                 registerSC += 4;
                 registerPC = instruction.argument;
                 break;
             case InstructionName::RET:
                 registerSC -= 4;
-                registerPC = loadMemory4Stack(registerSC);
+                registerPC = loadMemory4Stack<Policy>(registerSC);
                 break;
             case InstructionName::PSH:
-                storeMemory4Stack(registerSC, registerA);
+                storeMemory4Stack<Policy>(registerSC, registerA);
                 registerSC += 4;
                 break;
             case InstructionName::POP:
-                registerA = loadMemory4Stack(registerSC -= 4);
+                registerA = loadMemory4Stack<Policy>(registerSC -= 4);
                 break;
             case InstructionName::LSA:
-                registerA = loadMemory4Stack(registerSC + instruction.argument);
+                registerA = loadMemory4Stack<Policy>(
+                    registerSC + instruction.argument);
                 break;
             case InstructionName::SSA:
-                storeMemory4Stack(registerSC + instruction.argument, registerA);
+                storeMemory4Stack<Policy>(
+                    registerSC + instruction.argument, registerA);
                 break;
             case InstructionName::LSC:
                 registerA = registerSC;
@@ -395,43 +657,32 @@ class ComputationState {
                 break;
 
             case InstructionName::PTU:
-                if (mock)
+                if constexpr (Policy::mock)
                     break;
-                std::cout << static_cast<uint32_t>(registerA);
+                output->putUnsigned(registerA);
                 break;
             case InstructionName::PTS:
-                if (mock)
+                if constexpr (Policy::mock)
                     break;
-                std::cout << static_cast<int32_t>(
+                output->putSigned(
                     Util::fromTwo_sComplement<uint32_t, int32_t, 32>(
                         registerA));
                 break;
             case InstructionName::PTB:
-                if (mock)
+                if constexpr (Policy::mock)
                     break;
-                std::cout << "0b" << std::bitset<32>(registerA);
+                output->put("0b" + std::bitset<32>(registerA).to_string());
                 break;
             case InstructionName::PTC:
-                if (mock)
+                if constexpr (Policy::mock)
                     break;
-                UTF8IO::putRune(static_cast<UTF8::rune_t>(registerA));
+                output->putRune(static_cast<UTF8::rune_t>(registerA));
+                break;
+            case InstructionName::GET:
+                registerA = getNumber<Policy>();
                 break;
-            case InstructionName::GET: {
-                if (mock) {
-                    registerA = 0;
-                    break; }
-                std::optional<uint32_t> oN{std::nullopt};
-                while (!oN.has_value()) {
-                    std::cout << "enter a number: ";
-                    std::string get;
-                    std::getline(std::cin, get);
-                    oN = Util::stringToOptionalUInt32(get);
-                }
-                registerA = static_cast<word_t>(oN.value());
-            }; break;
             case InstructionName::GTC:
-                std::cout << "enter a character: ";
-                registerA = static_cast<word_t>(UTF8IO::getRune());
+                registerA = getCharacter();
                 break;
 
             case InstructionName::RND:
@@ -442,23 +693,512 @@ class ComputationState {
                 return false;
         }
 
-        updateFlags();
-        std::flush(std::cout);
+        return true;
+    }
 
-        if (!ok)
-            return err("step: erroneous machine state");
+    /* An alternative to `runSwitch`, dispatching via a table of label
+       addresses (a GCC and Clang extension) instead of a central
+       `switch`. */
+    private: template<typename Policy>
+    StopReason runThreaded(uint_t const maxInstructions) {
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+        /* indexed by op-code; the order has to match `InstructionName` */
+        static void *const dispatchTable[]{
+            &&NOP, &&LDA, &&LDB, &&STA, &&STB, &&LIA, &&SIA, &&LPC, &&SPC,
+            &&LYA, &&SYA, &&JMP, &&JN, &&JNN, &&JZ, &&JNZ, &&JP, &&JNP, &&JE,
+            &&JNE, &&CAL, &&RET, &&PSH, &&POP, &&LSA, &&SSA, &&LSC, &&SSC,
+            &&MOV, &&NOT, &&SHL, &&SHR, &&INC, &&DEC, &&NEG, &&SWP, &&ADD,
+            &&SUB, &&AND, &&OR, &&XOR, &&GET, &&GTC, &&PTU, &&PTS, &&PTB,
+            &&PTC, &&RND, &&HLT};
+        static_assert(sizeof dispatchTable / sizeof *dispatchTable
+            == static_cast<std::size_t>(InstructionName::HLT) + 1);
+
+        bool const doCheckProfiler{!profilerHooks.empty()};
+        bool const doObserve{observing()};
+        uint_t budget{maxInstructions};
+        Instruction instruction{};
+
+        auto const jumps{[&](InstructionName const name) {
+            return InstructionNameRepresentationHandler::jumps(
+                name, registerA); }};
+
+        #define JOY_ASSEMBLER__DISPATCH() do { \
+            if (budget <= 0) \
+                return StopReason::BudgetExhausted; \
+            if (doCheckProfiler && isProfilerBoundary(registerPC)) { \
+                if (budget < maxInstructions) \
+                    return StopReason::ProfilerBoundary; \
+                checkProfiler(); } \
+            --budget; \
+            setTrap<Policy>(); \
+            instruction = nextInstruction<Policy>(); \
+            ++statistics.nInstructions; \
+            statistics.nMicroInstructions += \
+                InstructionNameRepresentationHandler::microInstructions( \
+                    instruction.name); \
+            if (doObserve) \
+                observe(registerPC - 5, instruction); \
+            goto *dispatchTable[static_cast<byte_t>(instruction.name)]; \
+        } while (false)
+
+        #define JOY_ASSEMBLER__JUMP_IF(CONDITION) do { \
+            if (CONDITION) \
+                registerPC = instruction.argument; \
+            JOY_ASSEMBLER__DISPATCH(); \
+        } while (false)
+
+        JOY_ASSEMBLER__DISPATCH();
+
+        NOP:
+            JOY_ASSEMBLER__DISPATCH();
+
+        LDA:
+            registerA = loadData4<Policy>(instruction.argument);
+            JOY_ASSEMBLER__DISPATCH();
+        LDB:
+            registerB = loadData4<Policy>(instruction.argument);
+            JOY_ASSEMBLER__DISPATCH();
+        STA:
+            storeData4<Policy>(instruction.argument, registerA);
+            JOY_ASSEMBLER__DISPATCH();
+        STB:
+            storeData4<Policy>(instruction.argument, registerB);
+            JOY_ASSEMBLER__DISPATCH();
+        LIA:
+            registerA = loadMemory4<Policy>(
+                registerB + instruction.argument, wordMemorySemanticData);
+            JOY_ASSEMBLER__DISPATCH();
+        SIA:
+            storeMemory4<Policy>(registerB + instruction.argument,
+                registerA, wordMemorySemanticData);
+            JOY_ASSEMBLER__DISPATCH();
+        LPC:
+            registerA = registerPC;
+            JOY_ASSEMBLER__DISPATCH();
+        SPC:
+            registerPC = registerA;
+            JOY_ASSEMBLER__DISPATCH();
+        LYA:
+            registerA = (registerA & 0xffffff00)
+                | (loadData<Policy>(instruction.argument) & 0x000000ff);
+            JOY_ASSEMBLER__DISPATCH();
+        SYA:
+            storeData<Policy>(instruction.argument, static_cast<byte_t>(
+                registerA & 0xff));
+            JOY_ASSEMBLER__DISPATCH();
+
+        JMP:
+            JOY_ASSEMBLER__JUMP_IF(true);
+        JN:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JN));
+        JNN:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JNN));
+        JZ:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JZ));
+        JNZ:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JNZ));
+        JP:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JP));
+        JNP:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JNP));
+        JE:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JE));
+        JNE:
+            JOY_ASSEMBLER__JUMP_IF(jumps(InstructionName::JNE));
+
+        CAL:
+            storeMemory4Stack<Policy>(registerSC, registerPC);
+            registerSC += 4;
+            registerPC = instruction.argument;
+            JOY_ASSEMBLER__DISPATCH();
+        RET:
+            registerSC -= 4;
+            registerPC = loadMemory4Stack<Policy>(registerSC);
+            JOY_ASSEMBLER__DISPATCH();
+        PSH:
+            storeMemory4Stack<Policy>(registerSC, registerA);
+            registerSC += 4;
+            JOY_ASSEMBLER__DISPATCH();
+        POP:
+            registerA = loadMemory4Stack<Policy>(registerSC -= 4);
+            JOY_ASSEMBLER__DISPATCH();
+        LSA:
+            registerA = loadMemory4Stack<Policy>(
+                registerSC + instruction.argument);
+            JOY_ASSEMBLER__DISPATCH();
+        SSA:
+            storeMemory4Stack<Policy>(
+                registerSC + instruction.argument, registerA);
+            JOY_ASSEMBLER__DISPATCH();
+        LSC:
+            registerA = registerSC;
+            JOY_ASSEMBLER__DISPATCH();
+        SSC:
+            registerSC = registerA;
+            JOY_ASSEMBLER__DISPATCH();
+
+        MOV:
+            registerA = instruction.argument;
+            JOY_ASSEMBLER__DISPATCH();
+        NOT:
+            registerA = ~registerA;
+            JOY_ASSEMBLER__DISPATCH();
+        SHL:
+            registerA = instruction.argument < 32
+                ? registerA << instruction.argument : 0;
+            JOY_ASSEMBLER__DISPATCH();
+        SHR:
+            registerA = instruction.argument < 32
+                ? registerA >> instruction.argument : 0;
+            JOY_ASSEMBLER__DISPATCH();
+        INC:
+            registerA += instruction.argument;
+            JOY_ASSEMBLER__DISPATCH();
+        DEC:
+            registerA -= instruction.argument;
+            JOY_ASSEMBLER__DISPATCH();
+        NEG:
+            registerA = Util::toTwo_sComplement<int32_t, uint32_t, 32>(
+                -Util::fromTwo_sComplement<uint32_t, int32_t, 32>(
+                    registerA));
+            JOY_ASSEMBLER__DISPATCH();
+
+        SWP:
+            std::swap(registerA, registerB);
+            JOY_ASSEMBLER__DISPATCH();
+        AND:
+            registerA &= registerB;
+            JOY_ASSEMBLER__DISPATCH();
+        OR:
+            registerA |= registerB;
+            JOY_ASSEMBLER__DISPATCH();
+        XOR:
+            registerA ^= registerB;
+            JOY_ASSEMBLER__DISPATCH();
+        ADD:
+            registerA += registerB;
+            JOY_ASSEMBLER__DISPATCH();
+        SUB:
+            registerA += Util::toTwo_sComplement<int32_t, uint32_t, 32>(
+                -Util::fromTwo_sComplement<uint32_t, int32_t, 32>(
+                    registerB));
+            JOY_ASSEMBLER__DISPATCH();
+
+        PTU:
+            if constexpr (!Policy::mock)
+                output->putUnsigned(registerA);
+            JOY_ASSEMBLER__DISPATCH();
+        PTS:
+            if constexpr (!Policy::mock)
+                output->putSigned(
+                    Util::fromTwo_sComplement<uint32_t, int32_t, 32>(
+                        registerA));
+            JOY_ASSEMBLER__DISPATCH();
+        PTB:
+            if constexpr (!Policy::mock)
+                output->put("0b" + std::bitset<32>(registerA).to_string());
+            JOY_ASSEMBLER__DISPATCH();
+        PTC:
+            if constexpr (!Policy::mock)
+                output->putRune(static_cast<UTF8::rune_t>(registerA));
+            JOY_ASSEMBLER__DISPATCH();
+        GET:
+            registerA = getNumber<Policy>();
+            JOY_ASSEMBLER__DISPATCH();
+        GTC:
+            registerA = getCharacter();
+            JOY_ASSEMBLER__DISPATCH();
+
+        RND:
+            registerA = rng.unif(registerA);
+            JOY_ASSEMBLER__DISPATCH();
+
+        HLT:
+            return StopReason::Halted;
+
+        #undef JOY_ASSEMBLER__JUMP_IF
+        #undef JOY_ASSEMBLER__DISPATCH
+#pragma GCC diagnostic pop
+#else
+        /* portable fallback */
+        return runSwitch<Policy>(maxInstructions);
+#endif
+    }
 
-        return true;
+    /* Executes hot basic blocks as native code and interprets everything
+       else. A block is only entered if the remaining budget covers all of
+       its instructions, keeping the statistics exact. */
+    private: template<typename Policy>
+    StopReason runNative(uint_t const maxInstructions) {
+        /* compiled blocks address memory through a flat pointer, which
+           sparse memory does not provide */
+        if constexpr (!JIT::available
+            || Policy::bounds == MemoryBounds::Dynamic)
+            return runSwitch<Policy>(maxInstructions);
+        /* compiled blocks do not observe their instructions one by one */
+        if (observing())
+            return runSwitch<Policy>(maxInstructions);
+
+        bool const doCheckProfiler{!profilerHooks.empty()};
+
+        for (uint_t n{0}; n < maxInstructions; ) {
+            if (doCheckProfiler && isProfilerBoundary(registerPC)) {
+                if (n > 0)
+                    return StopReason::ProfilerBoundary;
+                checkProfiler(); }
+
+            /* positions outside of memory are left to `nextInstruction`,
+               which reports them */
+            JIT::Block const*block{jit.lookup(registerPC)};
+            if (block == nullptr && registerPC < registerPC+4
+                && registerPC+4 < memory.size() && jit.visit(registerPC))
+                block = compileBlock(registerPC);
+            if (
+                block != nullptr
+                && block->statistics.nInstructions <= maxInstructions - n
+            ) {
+                JIT::State state{registerA, registerB, registerPC, registerSC,
+                    memory.data()};
+                block->code(&state);
+                registerA = state.registerA;
+                registerB = state.registerB;
+                registerPC = state.registerPC;
+                registerSC = state.registerSC;
+
+                statistics.nInstructions += block->statistics.nInstructions;
+                statistics.nMicroInstructions
+                    += block->statistics.nMicroInstructions;
+                debug.highestUsedMemoryLocation = std::max(
+                    debug.highestUsedMemoryLocation,
+                    block->highestUsedMemoryLocation);
+                n += block->statistics.nInstructions;
+                continue;
+            }
+
+            setTrap<Policy>();
+            Instruction const instruction{nextInstruction<Policy>()};
+
+            ++statistics.nInstructions;
+            statistics.nMicroInstructions += InstructionNameRepresentationHandler
+                ::microInstructions(instruction.name);
+
+            if (!execute<Policy>(instruction))
+                return StopReason::Halted;
+            ++n;
+        }
+
+        return StopReason::BudgetExhausted;
+    }
+
+    /* Translates the basic block starting at `begin`. Translation stops in
+       front of the first instruction which needs the interpreter: I/O,
+       stack instructions, memory accesses which cannot be proven valid at
+       compile time (or stores when the program is not static, since they
+       might modify code) and profiler directives. */
+    private: JIT::Block const*compileBlock(word_t const begin) {
+        JIT::Emitter emitter{};
+        ComputationStateStatistics blockStatistics{0, 0};
+        word_t highest{0};
+
+        auto const semanticAt{[&](word_t const m) {
+            return memory.semantics().size() > m
+                ? std::make_optional(memory.semantics()[m])
+                : std::nullopt; }};
+
+        auto const fetchable{[&](word_t const pc) {
+            if (pc > pc+4 || pc+4 >= memory.size())
+                return false;
+            if (!memory.hasSemantics())
+                return true;
+            if (semanticAt(pc) != MemorySemantic::InstructionHead)
+                return false;
+            for (word_t j{1}; j < 5; ++j)
+                if (semanticAt(pc+j) != MemorySemantic::Instruction)
+                    return false;
+            return true; }};
+
+        auto const accessible{[&](
+            word_t const m, word_t const width, bool const store
+        ) {
+            /* the address has to fit into a 32-bit displacement */
+            if (m > m+(width-1) || m+(width-1) >= memory.size()
+                || m+(width-1) > 0x7fffffff)
+                return false;
+            if (!memory.hasSemantics())
+                return !store;
+            for (word_t j{0}; j < width; ++j) {
+                std::optional<MemorySemantic> const oSem{semanticAt(m+j)};
+                bool const valid{width == 1
+                    ? oSem == MemorySemantic::DataHead
+                        || oSem == MemorySemantic::Data
+                    : oSem == wordMemorySemanticData[j]};
+                if (!valid)
+                    return false;
+            }
+            highest = std::max(highest, m+(width-1));
+            return true; }};
+
+        auto const peek{[&](word_t const pc) {
+            word_t argument{0};
+            for (word_t j{0}; j < 4; ++j)
+                argument |= static_cast<word_t>(memory[pc+1+j]) << 8*(
+                    memoryMode == MemoryMode::LittleEndian ? j : 3-j);
+            return Instruction{InstructionNameRepresentationHandler
+                ::fromByteCode(memory[pc]), argument}; }};
+
+        word_t pc{begin};
+        bool terminated{false};
+        while (
+            !terminated
+            && blockStatistics.nInstructions < JIT::maximumBlockLength
+        ) {
+            if (pc != begin && isProfilerBoundary(pc))
+                break;
+            if (!fetchable(pc))
+                break;
+
+            Instruction const instruction{peek(pc)};
+            word_t const argument{instruction.argument};
+            word_t const next{pc+5};
+            bool translated{true};
+
+            switch (instruction.name) {
+                case InstructionName::NOP:
+                    break;
+                case InstructionName::MOV:
+                    emitter.movA(argument);
+                    break;
+                case InstructionName::NOT:
+                    emitter.notA();
+                    break;
+                case InstructionName::NEG:
+                    emitter.negA();
+                    break;
+                case InstructionName::SHL:
+                    emitter.shlA(argument);
+                    break;
+                case InstructionName::SHR:
+                    emitter.shrA(argument);
+                    break;
+                case InstructionName::INC:
+                    emitter.addAImm(argument);
+                    break;
+                case InstructionName::DEC:
+                    emitter.subAImm(argument);
+                    break;
+                case InstructionName::SWP:
+                    emitter.swapAB();
+                    break;
+                case InstructionName::ADD:
+                    emitter.addAB();
+                    break;
+                case InstructionName::SUB:
+                    emitter.subAB();
+                    break;
+                case InstructionName::AND:
+                    emitter.andAB();
+                    break;
+                case InstructionName::OR:
+                    emitter.orAB();
+                    break;
+                case InstructionName::XOR:
+                    emitter.xorAB();
+                    break;
+                case InstructionName::LPC:
+                    emitter.movA(next);
+                    break;
+                case InstructionName::LSC:
+                    emitter.loadSC();
+                    break;
+                case InstructionName::SSC:
+                    emitter.storeSC();
+                    break;
+
+                case InstructionName::LDA:
+                    if ((translated = accessible(argument, 4, false)))
+                        emitter.loadA(argument, memoryMode);
+                    break;
+                case InstructionName::LDB:
+                    if ((translated = accessible(argument, 4, false)))
+                        emitter.loadB(argument, memoryMode);
+                    break;
+                case InstructionName::STA:
+                    if ((translated = accessible(argument, 4, true)))
+                        emitter.storeA(argument, memoryMode);
+                    break;
+                case InstructionName::STB:
+                    if ((translated = accessible(argument, 4, true)))
+                        emitter.storeB(argument, memoryMode);
+                    break;
+                case InstructionName::LYA:
+                    if ((translated = accessible(argument, 1, false)))
+                        emitter.loadByteA(argument);
+                    break;
+                case InstructionName::SYA:
+                    if ((translated = accessible(argument, 1, true)))
+                        emitter.storeByteA(argument);
+                    break;
+
+                case InstructionName::SPC:
+                    emitter.exitToA();
+                    terminated = true;
+                    break;
+                case InstructionName::JMP:
+                    emitter.exit(argument);
+                    terminated = true;
+                    break;
+                case InstructionName::JN: case InstructionName::JNN:
+                case InstructionName::JZ: case InstructionName::JNZ:
+                case InstructionName::JP: case InstructionName::JNP:
+                case InstructionName::JE: case InstructionName::JNE:
+                    emitter.exitIf(instruction.name, argument, next);
+                    terminated = true;
+                    break;
+
+                case InstructionName::LIA: case InstructionName::SIA:
+                case InstructionName::CAL: case InstructionName::RET:
+                case InstructionName::PSH: case InstructionName::POP:
+                case InstructionName::LSA: case InstructionName::SSA:
+                case InstructionName::GET: case InstructionName::GTC:
+                case InstructionName::PTU: case InstructionName::PTS:
+                case InstructionName::PTB: case InstructionName::PTC:
+                case InstructionName::RND: case InstructionName::HLT:
+                    translated = false;
+                    break;
+            }
+
+            if (!translated)
+                break;
+
+            ++blockStatistics.nInstructions;
+            blockStatistics.nMicroInstructions
+                += InstructionNameRepresentationHandler::microInstructions(
+                    instruction.name);
+            highest = std::max(highest, pc+4);
+            pc = next;
+        }
+
+        if (blockStatistics.nInstructions <= 0) {
+            jit.reject(begin);
+            return nullptr; }
+
+        if (!terminated)
+            emitter.exit(pc);
+
+        return jit.insert(emitter.getCode(), begin, pc, blockStatistics,
+            highest);
     }
 
     public: word_t storeInstruction(
             word_t const m, Instruction const instruction
     ) {
-        if (oMemorySemantics.has_value()) {
+        if (memory.hasSemantics()) {
             std::optional<std::string> e{
                 InstructionRepresentationHandler
                 ::staticallyValidInstruction(
-                    oMemorySemantics.value(), instruction)};
+                    memory.semantics(), instruction)};
             if (e.has_value())
                 err("instruction " + InstructionRepresentationHandler
                     ::toString(instruction) + ": " + e.value());
@@ -469,6 +1209,7 @@ class ComputationState {
         storeMemory4(1+m, instruction.argument,
             wordMemorySemanticNone/*TODO Why no semantic check?*/);
         debug.highestUsedMemoryLocation = 0;
+        verified = false;
         return 5;
     }
 
@@ -478,14 +1219,270 @@ class ComputationState {
         return 4;
     }
 
-    private: Instruction nextInstruction() {
-        byte_t opCode{loadMemory(
+    /* Stores `count` data words, `words[j]` or `words[0]` throughout when
+       `repeat`ing, as as many calls to `storeData` would. Only the first
+       word takes the checked path; the others share its memory semantics
+       and are copied into place. */
+    public: word_t storeDataBlock(
+        word_t const m, word_t const*const words, word_t const count,
+        bool const repeat
+    ) {
+        if (count == 0)
+            return 0;
+        storeData(m, words[0]);
+
+        std::size_t const size{4 * std::size_t{count}};
+        if (std::size_t{m} + size > memory.size()) {
+            for (word_t j{1}; j < count; ++j)
+                storeData(m + 4*j, words[repeat ? 0 : j]);
+            return static_cast<word_t>(size); }
+
+        bool const swap{(memoryMode == MemoryMode::LittleEndian)
+            != Util::hostIsLittleEndian()};
+        auto const image{[&](word_t const w) {
+            return swap ? Util::byteSwap(w) : w; }};
+
+        if (memory.isSparse())
+            for (word_t j{1}; j < count; ++j)
+                memory.sparseStore4(m + 4*j, image(words[repeat ? 0 : j]));
+        else if (repeat) {
+            byte_t *const block{memory.data() + m};
+            for (std::size_t done{4}; done < size; done *= 2)
+                std::memcpy(block + done, block, std::min(done, size - done)); }
+        else if (!swap)
+            std::memcpy(memory.data() + m + 4, words + 1, size - 4);
+        else
+            for (word_t j{1}; j < count; ++j) {
+                word_t const w{image(words[j])};
+                std::memcpy(memory.data() + m + 4*j, &w, sizeof w); }
+
+        return static_cast<word_t>(size);
+    }
+
+    /* Proves, once before a static program runs, that every instruction
+       in it is statically valid (see `InstructionRepresentationHandler
+       ::staticallyValidInstruction`) and decodes it in advance. Since
+       neither memory semantics nor code change while a static program
+       runs, `LDA`, `LDB`, `STA`, `STB`, `LYA` and `SYA` then access data
+       without any checks (see `loadData4`) and fetching an instruction
+       at a verified address needs none either. Only accesses at computed
+       addresses (`LIA`, `SIA` and the stack) and jumps to computed
+       targets (`SPC` and `RET`) are still checked while running. Object
+       files are not trusted; an invalid instruction puts the machine into
+       an erroneous state, as it does when assembling. If, moreover, the
+       stack depth is proven to stay within the stack, stack instructions
+       go unchecked as well. */
+    private: void verify() {
+        /* instructions stored by assembling or linking were checked and
+           reported on then; anything else is reported here, once */
+        auto const reject{[&](std::string const&msg) {
+            if (ok)
+                err(msg);
+            ok = false;
+            faultMessage = msg; }};
+
+        verified = true;
+        oStackDepth = std::nullopt;
+        stackProven = false;
+        if (!memory.hasSemantics())
+            return;
+
+        SemanticMap const&sem{memory.semantics()};
+        if (sem.size() > memory.size()) {
+            reject("memory semantics exceed the memory");
+            return; }
+
+        for (std::size_t pc{0}; pc < sem.size(); ++pc) {
+            if (sem[pc] != MemorySemantic::InstructionHead)
+                continue;
+            bool complete{pc+4 < sem.size()};
+            for (std::size_t j{1}; complete && j < 5; ++j)
+                complete = sem[pc+j] == MemorySemantic::Instruction;
+            if (!complete) {
+                reject("incomplete instruction at 0x" + Util::UInt32AsPaddedHex(
+                    static_cast<word_t>(pc)));
+                return; }
+
+            word_t argument{0};
+            for (std::size_t j{0}; j < 4; ++j)
+                argument |= static_cast<word_t>(memory.read(pc+1+j)) << 8*(
+                    memoryMode == MemoryMode::LittleEndian ? j : 3-j);
+            std::optional<InstructionName> const oName{
+                instructionDefinitions[memory.read(pc)].name};
+            /* an invalid op-code faults once it is fetched */
+            if (!oName.has_value())
+                continue;
+
+            Instruction const instruction{oName.value(), argument};
+            std::optional<std::string> const e{
+                InstructionRepresentationHandler::staticallyValidInstruction(
+                    sem, instruction)};
+            if (e.has_value()) {
+                reject("instruction " + InstructionRepresentationHandler
+                    ::toString(instruction) + ": " + e.value());
+                return; }
+            cacheDecodedInstruction(static_cast<word_t>(pc), instruction);
+        }
+
+        if (!debug.stackBoundaries.has_value())
+            return;
+        auto const[s0, s1]{debug.stackBoundaries.value()};
+        oStackDepth = StackAnalysis::maximumDepth(decodedInstructions,
+            debug.stackBoundaries.value(), registerPC, registerSC);
+        if (!oStackDepth.has_value() || oStackDepth.value() > s1 - s0
+            || s0 > s1 || s1 > sem.size() || (s1 - s0) % 4 != 0)
+            return;
+        /* unchecked stack instructions access the stack as data */
+        for (word_t m{s0}; m < s1; ++m)
+            if (sem[m] != wordMemorySemanticData[(m - s0) % 4])
+                return;
+        stackProven = true;
+    }
+
+    /* a warning when the stack of a static program is bound to a depth
+       (see `StackAnalysis`) which exceeds the declared stack */
+    public: std::optional<std::string> stackWarning() {
+        if (!verified)
+            verify();
+        if (!oStackDepth.has_value() || !debug.stackBoundaries.has_value())
+            return std::nullopt;
+        auto const[s0, s1]{debug.stackBoundaries.value()};
+        if (s0 > s1 || oStackDepth.value() <= s1 - s0)
+            return std::nullopt;
+        return std::make_optional("the stack may grow to "
+            + std::to_string(oStackDepth.value()) + " bytes, yet only "
+            + std::to_string(s1 - s0) + " were declared at @stack"); }
+
+    private: template<typename Policy>
+    Instruction nextInstruction() {
+        if (Instruction const*const cached{decodedInstructions.find(
+            registerPC)}; cached != nullptr) {
+            /* a cached instruction has already passed all bounds and
+               semantic checks, which cannot fail on a second fetch */
+            debug.highestUsedMemoryLocation = std::max(
+                debug.highestUsedMemoryLocation, registerPC+4);
+            registerPC += 5;
+            return *cached; }
+
+        word_t const pc{registerPC};
+        byte_t opCode{loadMemory<Policy>(
             registerPC++, MemorySemantic::InstructionHead)};
-        word_t argument{loadMemory4(
+        word_t argument{loadMemory4<Policy>(
             (registerPC += 4) - 4, wordMemorySemanticInstructionData)};
 
-        return Instruction{InstructionNameRepresentationHandler
+        Instruction const instruction{InstructionNameRepresentationHandler
             ::fromByteCode(opCode), argument};
+        cacheDecodedInstruction(pc, instruction);
+        return instruction;
+    }
+
+    private: void cacheDecodedInstruction(
+        word_t const pc, Instruction const&instruction
+    ) {
+        /* do not cache instructions wrapping around the address space, nor
+           ones far out in sparse memory, which would blow up the cache */
+        if (pc < pc+4 && (!memory.isSparse() || pc < sparseDecodeLimit)) {
+            if (decodedInstructions.size() <= pc)
+                decodedInstructions.resize(std::min<std::size_t>(
+                    (pc / Memory::pageSize + 1) * Memory::pageSize,
+                    memory.size()));
+            decodedInstructions.store(pc, instruction); }
+    }
+
+    /* whether executions are counted, profiled or modeled, each
+       instruction being passed to `observe` */
+    private: bool observing() const {
+        return debug.doCountExecutions || debug.doProfileCalls
+            || debug.doProfileBranches || oCacheModel.has_value(); }
+
+    /* `nextInstruction` moves past the instruction before it executes,
+       such that it was fetched from `pc` */
+    private: void observe(word_t const pc, Instruction const&instruction) {
+        if (debug.doCountExecutions)
+            countExecution(pc, instruction.name);
+        if (debug.doProfileCalls)
+            calls.execute(pc, instruction);
+        if (debug.doProfileBranches)
+            branches.execute(pc, instruction, registerA);
+        if (oCacheModel.has_value())
+            oCacheModel->execute(pc, instruction, registerB, registerSC); }
+
+    private: void countExecution(word_t const pc, InstructionName const name) {
+        ComputationStateStatistics *count{nullptr};
+        if (pc < pcStatistics.size())
+            count = &pcStatistics[pc];
+        else if (pc >= sparseDecodeLimit)
+            count = &farPCStatistics[pc];
+        else {
+            pcStatistics.resize((pc / Memory::pageSize + 1) * Memory::pageSize,
+                ComputationStateStatistics{0, 0});
+            count = &pcStatistics[pc]; }
+
+        ++count->nInstructions;
+        count->nMicroInstructions
+            += InstructionNameRepresentationHandler::microInstructions(name);
+    }
+
+    /* the statistics of every address at which instructions were executed
+       (see `debug.doCountExecutions`) */
+    public: std::map<word_t, ComputationStateStatistics> executions() const {
+        std::map<word_t, ComputationStateStatistics> executions{
+            farPCStatistics};
+        for (std::size_t pc{0}; pc < pcStatistics.size(); ++pc)
+            if (pcStatistics[pc].nInstructions > 0)
+                executions.emplace(static_cast<word_t>(pc), pcStatistics[pc]);
+        return executions; }
+
+    /* the call paths executions were attributed to (see
+       `debug.doProfileCalls`) */
+    public: CallGraph const&callGraph() const {
+        return calls; }
+
+    /* the conditional jumps executed (see `debug.doProfileBranches`) */
+    public: BranchProfile const&branchProfile() const {
+        return branches; }
+
+    /* models caches and cycles from now on (see `CacheModel`) */
+    public: void modelCaches(CacheModel::Configuration const&configuration) {
+        oCacheModel.emplace(configuration); }
+
+    public: std::optional<CacheModel> const&cacheModel() const {
+        return oCacheModel; }
+
+    public: ComputationStateStatistics const&getStatistics() const {
+        return statistics; }
+
+    private: void invalidateDecodedInstructions(
+        word_t const m, word_t const width=1
+    ) {
+        for (
+            uint_t pc{m < 4 ? 0 : m-4};
+            pc <= m+(width-1) && pc < decodedInstructions.size();
+            ++pc
+        )
+            decodedInstructions.erase(pc);
+    }
+
+    private: template<typename Policy>
+    word_t getNumber() {
+        if constexpr (Policy::mock)
+            return 0;
+
+        std::optional<word_t> oN{std::nullopt};
+        while (!oN.has_value()) {
+            if (input->interactive())
+                output->put("enter a number: ");
+            output->awaitInput();
+            oN = input->getNumber();
+        }
+        return oN.value();
+    }
+
+    private: word_t getCharacter() {
+        if (input->interactive())
+            output->put("enter a character: ");
+        output->awaitInput();
+        return static_cast<word_t>(input->getRune());
     }
 
     private: void updateFlags() {
@@ -494,130 +1491,309 @@ class ComputationState {
             registerA) < 0;
         flagAEven = registerA % 2 == 0; }
 
-    private: byte_t loadMemory(
+    private: template<typename Policy> byte_t loadMemory(
         word_t const m,
         std::optional<MemorySemantic> const&oSem=std::nullopt
     ) {
         debug.highestUsedMemoryLocation = std::max(
             debug.highestUsedMemoryLocation, m);
 
-        if (/*m < 0 || */m >= memory.size()) {
-            if (!memoryIsDynamic)
+        if constexpr (Policy::bounds == MemoryBounds::Fixed) {
+            if (/*m < 0 || */m >= memory.size())
                 throw std::runtime_error{"loadMemory: memory out of bounds ("
                     + std::to_string(m) + " >= " + std::to_string(memory.size())
                     + ")"};
-            memory.resize(m+1);
+        } else if constexpr (Policy::bounds == MemoryBounds::Dynamic) {
+            if (m >= memory.size())
+                memory.resize(std::size_t{m}+1);
         }
 
-        if (oSem.has_value() && oMemorySemantics.has_value()) {
-            if (oMemorySemantics.value().size() <= m)
-                throw std::runtime_error{"loadMemory: no semantics available"};
-            if (oMemorySemantics.value()[m] != oSem.value())
-                throw std::runtime_error{
-                    "loadMemory: statically invalid memory access"};
-        }
+        if constexpr (Policy::checkSemantics)
+            if (oSem.has_value()) {
+                if (memory.semantics().size() <= m)
+                    throw std::runtime_error{
+                        "loadMemory: no semantics available"};
+                if (memory.semantics()[m] != oSem.value())
+                    throw std::runtime_error{
+                        "loadMemory: statically invalid memory access"};
+            }
 
-        return memory[m];
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            return memory.sparseLoad(m);
+        else
+            return memory[m];
     }
 
-    private: void storeMemory(
+    private: template<typename Policy> void storeMemory(
         word_t const m, byte_t const b,
         std::optional<MemorySemantic> const&oSem=std::nullopt
     ) {
         debug.highestUsedMemoryLocation = std::max(
             debug.highestUsedMemoryLocation, m);
 
-        if (/*m < 0 || */m >= memory.size()) {
-            if (!memoryIsDynamic)
+        if constexpr (Policy::bounds == MemoryBounds::Fixed) {
+            if (/*m < 0 || */m >= memory.size())
                 throw std::runtime_error{"storeMemory: memory out of bounds ("
                     + std::to_string(m) + " >= " + std::to_string(memory.size())
                     + ")"};
-            memory.resize(m+1);
+        } else if constexpr (Policy::bounds == MemoryBounds::Dynamic) {
+            if (m >= memory.size())
+                memory.resize(std::size_t{m}+1);
         }
 
-        if (oSem.has_value() && oMemorySemantics.has_value()) {
-            if (oMemorySemantics.value().size() <= m)
-                throw std::runtime_error{"storeMemory: no semantics available"};
-            if (oMemorySemantics.value()[m] != oSem.value())
-                throw std::runtime_error{
-                    "storeMemory: statically invalid memory access"};
+        if constexpr (Policy::checkSemantics)
+            if (oSem.has_value()) {
+                if (memory.semantics().size() <= m)
+                    throw std::runtime_error{
+                        "storeMemory: no semantics available"};
+                if (memory.semantics()[m] != oSem.value())
+                    throw std::runtime_error{
+                        "storeMemory: statically invalid memory access"};
+            }
+
+        invalidateDecodedInstructions(m);
+        jit.invalidate(m);
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            memory.sparseStore(m, b);
+        else
+            memory[m] = b;
+    }
+
+    /* Whether the word at `m` lies in memory and passes all semantic
+       checks, byte `m+j` being checked against `wordMemorySemantic[
+       order[j]]`. Only then can a word access skip the byte-wise path. */
+    private: template<typename Policy> bool wordAccessible(
+        word_t const m, WordMemorySemantic const&wordMemorySemantic,
+        std::array<std::size_t, 4> const&order
+    ) const {
+        /* see `guardMemory` for why guarded words cannot wrap around */
+        if constexpr (Policy::bounds != MemoryBounds::Guarded)
+            if (m > m+3 || m+3 >= memory.size())
+                return false;
+
+        /* one comparison of four packed semantics */
+        if constexpr (Policy::checkSemantics) {
+            auto const[mask, value]{
+                SemanticMap::pattern(wordMemorySemantic, order)};
+            if (mask != 0x00) {
+                SemanticMap const&sem{memory.semantics()};
+                if (m > m+3 || m+3 >= sem.size()
+                    || (sem.word(m) & mask) != value)
+                    return false; }
         }
 
-        memory[m] = b;
+        return true;
     }
 
-    private: word_t loadMemory4(
+    private: template<typename Policy> word_t loadMemory4(
         word_t const m,
         WordMemorySemantic const&wordMemorySemantic
     ) {
-        byte_t b3{0}, b2{0}, b1{0}, b0{0};
-        switch (memoryMode) {
-            case MemoryMode::LittleEndian:
-                b3 = loadMemory(m+3, wordMemorySemantic[3]);
-                b2 = loadMemory(m+2, wordMemorySemantic[2]);
-                b1 = loadMemory(m+1, wordMemorySemantic[1]);
-                b0 = loadMemory(m+0, wordMemorySemantic[0]);
-                break;
+        bool constexpr littleEndian{
+            Policy::memoryMode == MemoryMode::LittleEndian};
+
+        /* a single bounds check for the whole word; the byte-wise path
+           below reports errors exactly as before */
+        if (wordAccessible<Policy>(m, wordMemorySemantic, littleEndian
+            ? std::array<std::size_t, 4>{0, 1, 2, 3}
+            : std::array<std::size_t, 4>{3, 2, 1, 0})
+        ) {
+            debug.highestUsedMemoryLocation = std::max(
+                debug.highestUsedMemoryLocation, m+3);
+            word_t w;
+            if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+                w = memory.sparseLoad4(m);
+            else
+                std::memcpy(&w, memory.data() + m, sizeof w);
+            return littleEndian == Util::hostIsLittleEndian()
+                ? w : Util::byteSwap(w);
+        }
 
-            case MemoryMode::BigEndian:
-                b3 = loadMemory(m+0, wordMemorySemantic[3]);
-                b2 = loadMemory(m+1, wordMemorySemantic[2]);
-                b1 = loadMemory(m+2, wordMemorySemantic[1]);
-                b0 = loadMemory(m+3, wordMemorySemantic[0]);
-                break;
+        byte_t b3{0}, b2{0}, b1{0}, b0{0};
+        if constexpr (littleEndian) {
+            b3 = loadMemory<Policy>(m+3, wordMemorySemantic[3]);
+            b2 = loadMemory<Policy>(m+2, wordMemorySemantic[2]);
+            b1 = loadMemory<Policy>(m+1, wordMemorySemantic[1]);
+            b0 = loadMemory<Policy>(m+0, wordMemorySemantic[0]);
+        } else {
+            b3 = loadMemory<Policy>(m+0, wordMemorySemantic[3]);
+            b2 = loadMemory<Policy>(m+1, wordMemorySemantic[2]);
+            b1 = loadMemory<Policy>(m+2, wordMemorySemantic[1]);
+            b0 = loadMemory<Policy>(m+3, wordMemorySemantic[0]);
         }
 
         return (b3 << 24) | (b2 << 16) | (b1 << 8) | b0;
     }
 
-    private: void storeMemory4(
+    private: template<typename Policy> void storeMemory4(
         word_t const m, word_t const w,
         WordMemorySemantic const&wordMemorySemantic
     ) {
+        bool constexpr littleEndian{
+            Policy::memoryMode == MemoryMode::LittleEndian};
+
+        if (wordAccessible<Policy>(m, wordMemorySemantic, littleEndian
+            ? std::array<std::size_t, 4>{0, 2, 1, 3}
+            : std::array<std::size_t, 4>{3, 1, 2, 0})
+        ) {
+            debug.highestUsedMemoryLocation = std::max(
+                debug.highestUsedMemoryLocation, m+3);
+            invalidateDecodedInstructions(m, 4);
+            jit.invalidate(m, 4);
+            word_t const v{littleEndian == Util::hostIsLittleEndian()
+                ? w : Util::byteSwap(w)};
+            if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+                memory.sparseStore4(m, v);
+            else
+                std::memcpy(memory.data() + m, &v, sizeof v);
+            return;
+        }
+
         byte_t const b3{static_cast<byte_t>((w >> 24) & 0xff)};
         byte_t const b2{static_cast<byte_t>((w >> 16) & 0xff)};
         byte_t const b1{static_cast<byte_t>((w >>  8) & 0xff)};
         byte_t const b0{static_cast<byte_t>( w        & 0xff)};
-        switch (memoryMode) {
-            case MemoryMode::LittleEndian:
-                storeMemory(m+3, b3, wordMemorySemantic[3]);
-                storeMemory(m+2, b2, wordMemorySemantic[1]);
-                storeMemory(m+1, b1, wordMemorySemantic[2]);
-                storeMemory(m+0, b0, wordMemorySemantic[0]);
-                break;
-
-            case MemoryMode::BigEndian:
-                storeMemory(m+0, b3, wordMemorySemantic[3]);
-                storeMemory(m+1, b2, wordMemorySemantic[1]);
-                storeMemory(m+2, b1, wordMemorySemantic[2]);
-                storeMemory(m+3, b0, wordMemorySemantic[0]);
-                break;
+        if constexpr (littleEndian) {
+            storeMemory<Policy>(m+3, b3, wordMemorySemantic[3]);
+            storeMemory<Policy>(m+2, b2, wordMemorySemantic[1]);
+            storeMemory<Policy>(m+1, b1, wordMemorySemantic[2]);
+            storeMemory<Policy>(m+0, b0, wordMemorySemantic[0]);
+        } else {
+            storeMemory<Policy>(m+0, b3, wordMemorySemantic[3]);
+            storeMemory<Policy>(m+1, b2, wordMemorySemantic[1]);
+            storeMemory<Policy>(m+2, b1, wordMemorySemantic[2]);
+            storeMemory<Policy>(m+3, b0, wordMemorySemantic[0]);
         }
     }
 
+    /* Accesses at a constant address, made by `LDA`, `LDB`, `STA`, `STB`,
+       `LYA` and `SYA`. In a static program, `verify` proved the address to
+       hold data, such that there is nothing left to check and no decoded
+       instruction can be overwritten. */
+    private: template<typename Policy> word_t loadData4(word_t const m) {
+        if constexpr (!Policy::checkSemantics)
+            return loadMemory4<Policy>(m, wordMemorySemanticData);
+
+        debug.highestUsedMemoryLocation = std::max(
+            debug.highestUsedMemoryLocation, m+3);
+        word_t w;
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            w = memory.sparseLoad4(m);
+        else
+            std::memcpy(&w, memory.data() + m, sizeof w);
+        return (Policy::memoryMode == MemoryMode::LittleEndian)
+            == Util::hostIsLittleEndian() ? w : Util::byteSwap(w);
+    }
+
+    private: template<typename Policy> void storeData4(
+        word_t const m, word_t const w
+    ) {
+        if constexpr (!Policy::checkSemantics) {
+            storeMemory4<Policy>(m, w, wordMemorySemanticData);
+            return; }
+
+        debug.highestUsedMemoryLocation = std::max(
+            debug.highestUsedMemoryLocation, m+3);
+        word_t const v{(Policy::memoryMode == MemoryMode::LittleEndian)
+            == Util::hostIsLittleEndian() ? w : Util::byteSwap(w)};
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            memory.sparseStore4(m, v);
+        else
+            std::memcpy(memory.data() + m, &v, sizeof v);
+    }
+
+    private: template<typename Policy> byte_t loadData(word_t const m) {
+        if constexpr (!Policy::checkSemantics)
+            return loadMemory<Policy>(m);
+
+        debug.highestUsedMemoryLocation = std::max(
+            debug.highestUsedMemoryLocation, m);
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            return memory.sparseLoad(m);
+        else
+            return memory[m];
+    }
+
+    private: template<typename Policy> void storeData(
+        word_t const m, byte_t const b
+    ) {
+        if constexpr (!Policy::checkSemantics) {
+            storeMemory<Policy>(m, b);
+            return; }
+
+        debug.highestUsedMemoryLocation = std::max(
+            debug.highestUsedMemoryLocation, m);
+        if constexpr (Policy::bounds == MemoryBounds::Dynamic)
+            memory.sparseStore(m, b);
+        else
+            memory[m] = b;
+    }
+
+    /* runtime-configured memory access for code outside of the execution
+       engines */
+    private: byte_t loadMemory(
+        word_t const m,
+        std::optional<MemorySemantic> const&oSem=std::nullopt
+    ) {
+        return withPolicy([&](auto policy) {
+            return loadMemory<decltype(policy)>(m, oSem); }); }
+
+    private: void storeMemory(
+        word_t const m, byte_t const b,
+        std::optional<MemorySemantic> const&oSem=std::nullopt
+    ) {
+        withPolicy([&](auto policy) {
+            storeMemory<decltype(policy)>(m, b, oSem); }); }
+
+    private: word_t loadMemory4(
+        word_t const m,
+        WordMemorySemantic const&wordMemorySemantic
+    ) {
+        return withPolicy([&](auto policy) {
+            return loadMemory4<decltype(policy)>(m, wordMemorySemantic); }); }
+
+    private: void storeMemory4(
+        word_t const m, word_t const w,
+        WordMemorySemantic const&wordMemorySemantic
+    ) {
+        withPolicy([&](auto policy) {
+            storeMemory4<decltype(policy)>(m, w, wordMemorySemantic); }); }
+
     private: void assureStackBoundaries(
-        std::string const&callSite, word_t const m
+        char const*const callSite, word_t const m
     ) {
         if (!debug.stackBoundaries.has_value())
             throw std::runtime_error{
-                callSite + ": no stack boundaries are defined"};
+                std::string{callSite} + ": no stack boundaries are defined"};
 
         auto const[s0, s1]{debug.stackBoundaries.value()};
         if (m < s0)
-            throw std::runtime_error{callSite + ": stack underflow"};
+            throw std::runtime_error{std::string{callSite}
+                + ": stack underflow"};
         if (m >= s1)
-            throw std::runtime_error{callSite + ": stack overflow"};
+            throw std::runtime_error{std::string{callSite}
+                + ": stack overflow"};
         if ((m - s0) % 4 != 0)
-            throw std::runtime_error{callSite + ": stack misalignment"};
+            throw std::runtime_error{std::string{callSite}
+                + ": stack misalignment"};
     }
 
-    private: word_t loadMemory4Stack(word_t const m) {
+    private: template<typename Policy> word_t loadMemory4Stack(
+        word_t const m
+    ) {
+        if constexpr (!Policy::checkStack)
+            return loadData4<Policy>(m);
         assureStackBoundaries("loadMemory4Stack", m);
-        return loadMemory4(m, wordMemorySemanticData); }
+        return loadMemory4<Policy>(m, wordMemorySemanticData); }
 
-    private: void storeMemory4Stack(word_t const m, word_t const w) {
+    private: template<typename Policy> void storeMemory4Stack(
+        word_t const m, word_t const w
+    ) {
+        if constexpr (!Policy::checkStack) {
+            storeData4<Policy>(m, w);
+            return; }
         assureStackBoundaries("storeMemory4Stack", m);
-        storeMemory4(m, w, wordMemorySemanticData); }
+        storeMemory4<Policy>(m, w, wordMemorySemanticData); }
 
     private: bool err(std::string const&msg) const {
         std::cerr << "ComputationState: " << msg << std::endl;
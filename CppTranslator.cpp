@@ -0,0 +1,616 @@
+#ifndef JOY_ASSEMBLER__CPP_TRANSLATOR_CPP
+#define JOY_ASSEMBLER__CPP_TRANSLATOR_CPP
+
+#include "Includes.hpp"
+
+/* Translates an assembled program into a standalone C++17 translation
+   unit. Every instruction becomes a label in `main`; statically known
+   jumps become `goto`s, computed jumps (`spc`, `ret`) go through a
+   `switch` over all instruction positions. Whenever execution leaves the
+   translated code -- by jumping to a position which does not hold an
+   instruction or, for non-static programs, by writing into code -- an
+   embedded interpreter takes over. */
+class CppTranslator {
+    private:
+        ComputationState const&cs;
+
+    public: CppTranslator(ComputationState const&cs) :
+        cs{cs}
+    { ; }
+
+    public: bool translate(
+        std::ostream &out, std::string const&source
+    ) const {
+        if (!cs.profiler.empty())
+            return error("emit-cpp: profiler directives are not supported");
+        if (!cs.ok)
+            return error("emit-cpp: erroneous machine state");
+
+        std::vector<word_t> const addresses{
+            cs.debug.sourceMap.instructionAddresses()};
+        std::set<word_t> const labels{addresses.begin(), addresses.end()};
+        bool const isStatic{cs.memory.hasSemantics()};
+
+        out << "/* generated by Joy Assembler from \"" << source
+            << "\"; do not edit */\n\n";
+        out << runtimeHeader;
+
+        out << "    bool constexpr bigEndian{"
+            << boolean(cs.memoryMode == MemoryMode::BigEndian) << "};\n";
+        out << "    bool constexpr memoryIsDynamic{"
+            << boolean(cs.memoryIsDynamic) << "};\n";
+        out << "    std::size_t constexpr memorySize{"
+            << cs.memory.size() << "};\n";
+
+        /* trailing zeros are restored by resizing on start-up */
+        std::size_t imageSize{cs.memory.size()};
+        while (imageSize > 0 && cs.memory.read(imageSize-1) == 0)
+            --imageSize;
+        out << "    std::vector<byte_t> memory{";
+        for (std::size_t m{0}; m < imageSize; ++m)
+            out << (m % 16 == 0 ? "\n        " : " ") << "0x"
+                << Util::UInt8AsPaddedHex(cs.memory.read(m)) << ",";
+        out << "};\n";
+
+        out << "    bool constexpr hasSemantics{" << boolean(isStatic)
+            << "};\n";
+        out << "    std::vector<byte_t> const semantics{";
+        if (isStatic) {
+            SemanticMap const&sem{cs.memory.semantics()};
+            for (std::size_t m{0}; m < sem.size(); ++m)
+                out << (m % 32 == 0 ? "\n        " : " ")
+                    << static_cast<int>(sem[m]) << ",";
+        }
+        out << "};\n";
+
+        auto const[stackBegin, stackEnd]{cs.debug.stackBoundaries.value_or(
+            std::make_tuple(word_t{0}, word_t{0}))};
+        out << "    bool constexpr hasStack{"
+            << boolean(cs.debug.stackBoundaries.has_value()) << "};\n";
+        out << "    word_t constexpr stackBegin{" << hex(stackBegin)
+            << "}, stackEnd{" << hex(stackEnd) << "};\n";
+
+        word_t codeBegin{0}, codeEnd{0};
+        if (!addresses.empty()) {
+            codeBegin = addresses.front();
+            codeEnd = addresses.back() + 5; }
+        out << "    word_t constexpr codeBegin{" << hex(codeBegin)
+            << "}, codeEnd{" << hex(codeEnd) << "};\n";
+
+        out << "    word_t A{" << hex(cs.registerA) << "}, B{"
+            << hex(cs.registerB) << "}, PC{" << hex(cs.registerPC) << "}, SC{"
+            << hex(cs.registerSC) << "};\n";
+
+        out << "    bool constexpr rngIsSeeded{"
+            << boolean(cs.rng.isSeeded()) << "};\n";
+        out << "    char const rngState[]{\"" << cs.rng.state() << "\"};\n";
+
+        out << runtime;
+
+        /* embedded interpreter */
+        out << "    int interpret() {\n"
+            << "        for (;;) {\n"
+            << "            byte_t const opCode{load(PC, INSTRUCTION_HEAD)};\n"
+            << "            word_t const argument{load4(PC+1, "
+                "INSTRUCTION_WORD)};\n"
+            << "            PC += 5;\n"
+            << "            switch (opCode) {\n";
+        for (uint16_t opCode{0}; opCode < 0x100; ++opCode) {
+            InstructionDefinition const&idef{instructionDefinitions[opCode]};
+            if (!idef.opCodeUsed)
+                continue;
+            out << "                case " << opCode << ": /* "
+                << idef.getNameRepresentation() << " */\n"
+                << "                    "
+                << interpreted(idef.name) << "\n"
+                << "                    break;\n";
+        }
+        out << "                default:\n"
+            << "                    /* unused op-codes act as `nop` */\n"
+            << "                    break;\n"
+            << "            }\n"
+            << "        }\n"
+            << "    }\n"
+            << "}\n\n";
+
+        /* translated program */
+        out << "int main() {\n"
+            << "    initialize();\n\n"
+            << "    dispatch:\n"
+            << "    switch (PC) {\n";
+        for (word_t const address : addresses)
+            out << "        case " << hex(address) << ": goto " << label(address)
+                << ";\n";
+        out << "        default: return interpret();\n"
+            << "    }\n";
+
+        for (std::size_t j{0}; j < addresses.size(); ++j) {
+            word_t const address{addresses[j]};
+            word_t const next{address+5};
+            Instruction const instruction{decode(address)};
+
+            out << "\n    " << label(address) << ": /* "
+                << InstructionRepresentationHandler::toString(instruction)
+                << " */\n";
+            out << "    " << translated(instruction, next, labels, isStatic)
+                << "\n";
+
+            bool const fallsThrough{j+1 < addresses.size()
+                && addresses[j+1] == next};
+            if (!fallsThrough)
+                out << "    PC = " << hex(next) << "; goto dispatch;\n";
+        }
+        out << "}\n";
+
+        return true;
+    }
+
+    private: Instruction decode(word_t const m) const {
+        word_t argument{0};
+        for (word_t j{0}; j < 4; ++j)
+            argument |= static_cast<word_t>(cs.memory.read(m+1+j)) << 8*(
+                cs.memoryMode == MemoryMode::LittleEndian ? j : 3-j);
+        return Instruction{InstructionNameRepresentationHandler
+            ::fromByteCode(cs.memory.read(m)), argument}; }
+
+    private: static std::string condition(InstructionName const name) {
+        switch (name) {
+            case InstructionName::JMP: return "true";
+            case InstructionName::JN:  return "signedA() < 0";
+            case InstructionName::JNN: return "signedA() >= 0";
+            case InstructionName::JZ:  return "A == 0";
+            case InstructionName::JNZ: return "A != 0";
+            case InstructionName::JP:  return "signedA() > 0";
+            case InstructionName::JNP: return "signedA() <= 0";
+            case InstructionName::JE:  return "A % 2 == 0";
+            case InstructionName::JNE: return "A % 2 != 0";
+
+            case InstructionName::NOP: case InstructionName::LDA:
+            case InstructionName::LDB: case InstructionName::STA:
+            case InstructionName::STB: case InstructionName::LIA:
+            case InstructionName::SIA: case InstructionName::LPC:
+            case InstructionName::SPC: case InstructionName::LYA:
+            case InstructionName::SYA: case InstructionName::CAL:
+            case InstructionName::RET: case InstructionName::PSH:
+            case InstructionName::POP: case InstructionName::LSA:
+            case InstructionName::SSA: case InstructionName::LSC:
+            case InstructionName::SSC: case InstructionName::MOV:
+            case InstructionName::NOT: case InstructionName::SHL:
+            case InstructionName::SHR: case InstructionName::INC:
+            case InstructionName::DEC: case InstructionName::NEG:
+            case InstructionName::SWP: case InstructionName::ADD:
+            case InstructionName::SUB: case InstructionName::AND:
+            case InstructionName::OR:  case InstructionName::XOR:
+            case InstructionName::GET: case InstructionName::GTC:
+            case InstructionName::PTU: case InstructionName::PTS:
+            case InstructionName::PTB: case InstructionName::PTC:
+            case InstructionName::RND: case InstructionName::HLT:
+                break;
+        }
+        return "false"; }
+
+    /* C++ code of a non-jumping instruction; `argument` and `next` are
+       C++ expressions for the instruction's argument and the program
+       position following it */
+    private: static std::optional<std::string> statement(
+        InstructionName const name,
+        std::string const&argument, std::string const&next
+    ) {
+        switch (name) {
+            case InstructionName::NOP: return "";
+            case InstructionName::LDA:
+                return "A = load4(" + argument + ", DATA_WORD);";
+            case InstructionName::LDB:
+                return "B = load4(" + argument + ", DATA_WORD);";
+            case InstructionName::STA:
+                return "store4(" + argument + ", A, DATA_WORD);";
+            case InstructionName::STB:
+                return "store4(" + argument + ", B, DATA_WORD);";
+            case InstructionName::LIA:
+                return "A = load4(B + " + argument + ", DATA_WORD);";
+            case InstructionName::SIA:
+                return "store4(B + " + argument + ", A, DATA_WORD);";
+            case InstructionName::LPC: return "A = " + next + ";";
+            case InstructionName::LYA:
+                return "A = (A & 0xffffff00u) | load(" + argument + ");";
+            case InstructionName::SYA:
+                return "store(" + argument + ", "
+                    "static_cast<byte_t>(A & 0xffu));";
+            case InstructionName::PSH:
+                return "store4Stack(SC, A); SC += 4;";
+            case InstructionName::POP: return "A = load4Stack(SC -= 4);";
+            case InstructionName::LSA:
+                return "A = load4Stack(SC + " + argument + ");";
+            case InstructionName::SSA:
+                return "store4Stack(SC + " + argument + ", A);";
+            case InstructionName::LSC: return "A = SC;";
+            case InstructionName::SSC: return "SC = A;";
+            case InstructionName::MOV: return "A = " + argument + ";";
+            case InstructionName::NOT: return "A = ~A;";
+            case InstructionName::SHL:
+                return "A = " + argument + " < 32 ? A << " + argument
+                    + " : 0;";
+            case InstructionName::SHR:
+                return "A = " + argument + " < 32 ? A >> " + argument
+                    + " : 0;";
+            case InstructionName::INC: return "A += " + argument + ";";
+            case InstructionName::DEC: return "A -= " + argument + ";";
+            case InstructionName::NEG: return "A = 0u - A;";
+            case InstructionName::SWP: return "std::swap(A, B);";
+            case InstructionName::ADD: return "A += B;";
+            case InstructionName::SUB: return "A -= B;";
+            case InstructionName::AND: return "A &= B;";
+            case InstructionName::OR:  return "A |= B;";
+            case InstructionName::XOR: return "A ^= B;";
+            case InstructionName::GET: return "A = getNumber();";
+            case InstructionName::GTC: return "A = getCharacter();";
+            case InstructionName::PTU: return "std::cout << A;";
+            case InstructionName::PTS: return "std::cout << signedA();";
+            case InstructionName::PTB:
+                return "std::cout << \"0b\" << std::bitset<32>(A);";
+            case InstructionName::PTC: return "putRune(A);";
+            case InstructionName::RND: return "A = random(A);";
+
+            case InstructionName::SPC: case InstructionName::JMP:
+            case InstructionName::JN:  case InstructionName::JNN:
+            case InstructionName::JZ:  case InstructionName::JNZ:
+            case InstructionName::JP:  case InstructionName::JNP:
+            case InstructionName::JE:  case InstructionName::JNE:
+            case InstructionName::CAL: case InstructionName::RET:
+            case InstructionName::HLT:
+                break;
+        }
+        return std::nullopt; }
+
+    private: static bool doesStore(InstructionName const name) {
+        return Util::contains(std::array{
+            InstructionName::STA, InstructionName::STB,
+            InstructionName::SIA, InstructionName::SYA,
+            InstructionName::CAL, InstructionName::PSH,
+            InstructionName::SSA,
+        }, name); }
+
+    private: static std::string interpreted(InstructionName const name) {
+        std::optional<std::string> const oStatement{
+            statement(name, "argument", "PC")};
+        if (oStatement.has_value())
+            return oStatement.value();
+
+        if (name == InstructionName::SPC)
+            return "PC = A;";
+        if (name == InstructionName::CAL)
+            return "store4Stack(SC, PC); SC += 4; PC = argument;";
+        if (name == InstructionName::RET)
+            return "SC -= 4; PC = load4Stack(SC);";
+        if (name == InstructionName::HLT)
+            return "return EXIT_SUCCESS;";
+        return "if (" + condition(name) + ") PC = argument;";
+    }
+
+    private: std::string translated(
+        Instruction const&instruction, word_t const next,
+        std::set<word_t> const&labels, bool const isStatic
+    ) const {
+        auto const jump{[&](word_t const target) {
+            if (Util::std20::contains(labels, target))
+                return "goto " + label(target) + ";";
+            return "{ PC = " + hex(target) + "; goto dispatch; }"; }};
+
+        /* only non-static programs can write into code */
+        std::string const leaveIfModified{isStatic || !doesStore(
+            instruction.name) ? "" : " if (codeModified) { PC = " + hex(next)
+            + "; return interpret(); }"};
+
+        /* memory semantics never change at run time, such that accesses to
+           constant addresses in a static program can be checked once */
+        word_t const m{instruction.argument};
+        if (isStatic && cs.memoryMode == MemoryMode::LittleEndian
+            && staticallyAccessible(m)
+        ) {
+            InstructionName const name{instruction.name};
+            if (name == InstructionName::LDA)
+                return "A = peek4(" + hex(m) + ");";
+            if (name == InstructionName::LDB)
+                return "B = peek4(" + hex(m) + ");";
+            if (name == InstructionName::STA)
+                return "poke4(" + hex(m) + ", A);";
+            if (name == InstructionName::STB)
+                return "poke4(" + hex(m) + ", B);";
+        }
+
+        std::optional<std::string> const oStatement{statement(
+            instruction.name, hex(instruction.argument), hex(next))};
+        if (oStatement.has_value())
+            return oStatement.value() + leaveIfModified;
+
+        if (instruction.name == InstructionName::SPC)
+            return "PC = A; goto dispatch;";
+        if (instruction.name == InstructionName::CAL)
+            return "store4Stack(SC, " + hex(next) + "); SC += 4;"
+                + (isStatic ? "" : " if (codeModified) { PC = "
+                    + hex(instruction.argument) + "; return interpret(); }")
+                + " " + jump(instruction.argument);
+        if (instruction.name == InstructionName::RET)
+            return "SC -= 4; PC = load4Stack(SC); goto dispatch;";
+        if (instruction.name == InstructionName::HLT)
+            return "return EXIT_SUCCESS;";
+        return "if (" + condition(instruction.name) + ") "
+            + jump(instruction.argument);
+    }
+
+    private: bool staticallyAccessible(word_t const m) const {
+        SemanticMap const&sem{cs.memory.semantics()};
+        if (m > m+3 || m+3 >= cs.memory.size() || m+3 >= sem.size())
+            return false;
+        for (word_t j{0}; j < 4; ++j)
+            if (sem[m+j] != wordMemorySemanticData[j])
+                return false;
+        return true; }
+
+    private: static std::string label(word_t const address) {
+        return "L_" + Util::UInt32AsPaddedHex(address); }
+
+    private: static std::string hex(word_t const w) {
+        return "0x" + Util::UInt32AsPaddedHex(w) + "u"; }
+
+    private: static char const*boolean(bool const b) {
+        return b ? "true" : "false"; }
+
+    private: bool error(std::string const&msg) const {
+        std::cerr << msg << std::endl;
+        return false; }
+
+    private: static char const*const runtimeHeader;
+    private: static char const*const runtime;
+};
+
+char const*const CppTranslator::runtimeHeader{R"cpp(#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using byte_t = std::uint8_t;
+    using word_t = std::uint32_t;
+
+)cpp"};
+
+char const*const CppTranslator::runtime{R"cpp(
+    /* memory semantics, in the order of Joy Assembler's `MemorySemantic` */
+    int constexpr NONE{-1}, INSTRUCTION_HEAD{0}, INSTRUCTION{1},
+        DATA_HEAD{2}, DATA{3};
+    int constexpr DATA_WORD[4]{DATA_HEAD, DATA, DATA, DATA};
+    int constexpr INSTRUCTION_WORD[4]{
+        INSTRUCTION, INSTRUCTION, INSTRUCTION, INSTRUCTION};
+
+    bool codeModified{false};
+    std::mt19937 rng{};
+
+    void initialize() {
+        std::ios_base::sync_with_stdio(false);
+        memory.resize(memorySize);
+        if (rngIsSeeded) {
+            std::istringstream state{rngState};
+            state >> rng;
+        } else
+            rng.seed(std::random_device{}());
+    }
+
+    [[noreturn]] void fail(std::string const&msg) {
+        std::cout.flush();
+        std::cerr << "error: " << msg << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    byte_t &access(char const*callSite, word_t const m, int const sem) {
+        if (m >= memory.size()) {
+            if (!memoryIsDynamic)
+                fail(std::string{callSite} + ": memory out of bounds ("
+                    + std::to_string(m)
+                    + " >= " + std::to_string(memory.size()) + ")");
+            memory.resize(static_cast<std::size_t>(m)+1);
+        }
+        if (sem != NONE && hasSemantics) {
+            if (semantics.size() <= m)
+                fail(std::string{callSite} + ": no semantics available");
+            if (semantics[m] != sem)
+                fail(std::string{callSite}
+                    + ": statically invalid memory access");
+        }
+        return memory[m];
+    }
+
+    byte_t load(word_t const m, int const sem=NONE) {
+        return access("loadMemory", m, sem); }
+
+    void store(word_t const m, byte_t const b, int const sem=NONE) {
+        access("storeMemory", m, sem) = b;
+        if (codeBegin <= m && m < codeEnd)
+            codeModified = true; }
+
+    word_t load4(word_t const m, int const (&sem)[4]) {
+        word_t b3, b2, b1, b0;
+        if (!bigEndian) {
+            b3 = load(m+3, sem[3]); b2 = load(m+2, sem[2]);
+            b1 = load(m+1, sem[1]); b0 = load(m+0, sem[0]);
+        } else {
+            b3 = load(m+0, sem[3]); b2 = load(m+1, sem[2]);
+            b1 = load(m+2, sem[1]); b0 = load(m+3, sem[0]);
+        }
+        return (b3 << 24) | (b2 << 16) | (b1 << 8) | b0;
+    }
+
+    void store4(word_t const m, word_t const w, int const (&sem)[4]) {
+        byte_t const b3{static_cast<byte_t>((w >> 24) & 0xff)};
+        byte_t const b2{static_cast<byte_t>((w >> 16) & 0xff)};
+        byte_t const b1{static_cast<byte_t>((w >>  8) & 0xff)};
+        byte_t const b0{static_cast<byte_t>( w        & 0xff)};
+        if (!bigEndian) {
+            store(m+3, b3, sem[3]); store(m+2, b2, sem[1]);
+            store(m+1, b1, sem[2]); store(m+0, b0, sem[0]);
+        } else {
+            store(m+0, b3, sem[3]); store(m+1, b2, sem[1]);
+            store(m+2, b1, sem[2]); store(m+3, b0, sem[0]);
+        }
+    }
+
+    /* accesses which have been proven valid during translation */
+    inline word_t peek4(word_t const m) {
+        return static_cast<word_t>(memory[m+3]) << 24
+            | static_cast<word_t>(memory[m+2]) << 16
+            | static_cast<word_t>(memory[m+1]) <<  8
+            | static_cast<word_t>(memory[m+0]); }
+
+    inline void poke4(word_t const m, word_t const w) {
+        memory[m+3] = static_cast<byte_t>((w >> 24) & 0xff);
+        memory[m+2] = static_cast<byte_t>((w >> 16) & 0xff);
+        memory[m+1] = static_cast<byte_t>((w >>  8) & 0xff);
+        memory[m+0] = static_cast<byte_t>( w        & 0xff); }
+
+    void assureStack(char const*callSite, word_t const m) {
+        if (!hasStack)
+            fail(std::string{callSite} + ": no stack boundaries are defined");
+        if (m < stackBegin)
+            fail(std::string{callSite} + ": stack underflow");
+        if (m >= stackEnd)
+            fail(std::string{callSite} + ": stack overflow");
+        if ((m - stackBegin) % 4 != 0)
+            fail(std::string{callSite} + ": stack misalignment");
+    }
+
+    word_t load4Stack(word_t const m) {
+        assureStack("loadMemory4Stack", m);
+        return load4(m, DATA_WORD); }
+
+    void store4Stack(word_t const m, word_t const w) {
+        assureStack("storeMemory4Stack", m);
+        store4(m, w, DATA_WORD); }
+
+    std::int32_t signedA() {
+        return static_cast<std::int32_t>(A); }
+
+    word_t random(word_t const n) {
+        std::uniform_int_distribution<word_t> unif{0, n};
+        return unif(rng); }
+
+    /* accepts the same numerals as Joy Assembler's source literals */
+    std::optional<word_t> parseNumber(std::string const&s) {
+        std::string const space{" \t\n\v\f\r"};
+        std::size_t const b{s.find_first_not_of(space)};
+        if (b == std::string::npos)
+            return std::nullopt;
+        std::string t{s.substr(b, s.find_last_not_of(space) - b + 1)};
+
+        bool negative{false};
+        if (!t.empty() && (t[0] == '+' || t[0] == '-')) {
+            negative = t[0] == '-';
+            t.erase(0, 1); }
+
+        unsigned base{10};
+        if (t.size() > 2 && t[0] == '0' && (t[1] == 'x' || t[1] == 'X'))
+            base = 16;
+        else if (t.size() > 2 && t[0] == '0' && (t[1] == 'b' || t[1] == 'B'))
+            base = 2;
+        if (base != 10)
+            t.erase(0, 2);
+        if (t.empty())
+            return std::nullopt;
+
+        std::uint64_t n{0};
+        for (char const c : t) {
+            unsigned digit{base};
+            if ('0' <= c && c <= '9')
+                digit = static_cast<unsigned>(c - '0');
+            else if ('a' <= c && c <= 'f')
+                digit = static_cast<unsigned>(c - 'a' + 10);
+            else if ('A' <= c && c <= 'F')
+                digit = static_cast<unsigned>(c - 'A' + 10);
+            if (digit >= base)
+                return std::nullopt;
+            n = n * base + digit;
+            if (n > 0xffffffffull)
+                n = 0x100000000ull;
+        }
+
+        if (!negative && n <= 0xffffffffull)
+            return static_cast<word_t>(n);
+        if (negative && n <= 0x80000000ull)
+            return static_cast<word_t>(0u - static_cast<word_t>(n));
+        return std::nullopt;
+    }
+
+    word_t getNumber() {
+        std::optional<word_t> oN{std::nullopt};
+        while (!oN.has_value()) {
+            std::cout << "enter a number: ";
+            std::string get;
+            std::getline(std::cin, get);
+            oN = parseNumber(get);
+        }
+        return oN.value();
+    }
+
+    word_t constexpr ERROR_RUNE{0xfffd};
+
+    /* mirrors Joy Assembler's UTF-8 decoder, including its treatment of
+       malformed input */
+    word_t getCharacter() {
+        std::cout << "enter a character: ";
+        auto const get{[]() { return static_cast<byte_t>(std::cin.get()); }};
+
+        byte_t const lead{get()};
+        std::size_t length{0};
+        word_t rune{0}, minimum{0}, maximum{0};
+        if ((lead & 0x80) == 0x00)
+            return lead;
+        else if ((lead & 0xe0) == 0xc0)
+            length = 2, rune = lead & 0x1f, minimum = 0x80, maximum = 0x7ff;
+        else if ((lead & 0xf0) == 0xe0)
+            length = 3, rune = lead & 0x0f, minimum = 0x800, maximum = 0xffff;
+        else if ((lead & 0xf8) == 0xf0)
+            length = 4, rune = lead & 0x07, minimum = 0x10000,
+                maximum = 0x10ffff;
+        else
+            return ERROR_RUNE;
+
+        byte_t continuation[4]{};
+        for (std::size_t j{1}; j < length; ++j) {
+            continuation[j] = get();
+            /* a continuation byte is only validated once its successor
+               has been read; the last one is never validated */
+            for (std::size_t k{1}; k < j; ++k)
+                if ((continuation[k] & 0xc0) != 0x80)
+                    return ERROR_RUNE;
+            rune = (rune << 6) | (continuation[j] & 0x3f);
+        }
+        if (rune < minimum || rune > maximum)
+            return ERROR_RUNE;
+        return rune;
+    }
+
+    void putRune(word_t const rune) {
+        if (rune <= 0x7f)
+            std::cout.put(static_cast<char>(rune));
+        else if (rune <= 0x7ff) {
+            std::cout.put(static_cast<char>(0xc0 | ((rune >>  6) & 0x1f)));
+            std::cout.put(static_cast<char>(0x80 | ( rune        & 0x3f)));
+        } else if (rune <= 0xffff) {
+            std::cout.put(static_cast<char>(0xe0 | ((rune >> 12) & 0x0f)));
+            std::cout.put(static_cast<char>(0x80 | ((rune >>  6) & 0x3f)));
+            std::cout.put(static_cast<char>(0x80 | ( rune        & 0x3f)));
+        } else if (rune <= 0x10ffff) {
+            std::cout.put(static_cast<char>(0xf0 | ((rune >> 18) & 0x07)));
+            std::cout.put(static_cast<char>(0x80 | ((rune >> 12) & 0x3f)));
+            std::cout.put(static_cast<char>(0x80 | ((rune >>  6) & 0x3f)));
+            std::cout.put(static_cast<char>(0x80 | ( rune        & 0x3f)));
+        }
+    }
+
+)cpp"};
+
+#endif
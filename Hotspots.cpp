@@ -0,0 +1,59 @@
+#ifndef JOY_ASSEMBLER__HOTSPOTS_CPP
+#define JOY_ASSEMBLER__HOTSPOTS_CPP
+
+#include "Includes.hpp"
+
+/* Reports where a program spent its time: the executions counted per
+   address (see `ComputationStateDebug::doCountExecutions`) are attributed
+   to the source lines the instructions were assembled from, which are
+   listed by the share of all executed micro-instructions they account for.
+   Addresses no instruction was assembled to -- code written at run time
+   or loaded without a source map -- are listed by address. */
+class Hotspots {
+    private:
+        struct Row {
+            word_t address;
+            ComputationStateStatistics statistics;
+        };
+
+    public: static void report(
+        std::ostream &os, ComputationState const&cs, std::size_t const rows
+    ) {
+        std::vector<Row> hotspots{};
+        uint_t total{0};
+        for (auto const&[pc, statistics] : cs.executions()) {
+            hotspots.push_back(Row{pc, statistics});
+            total += statistics.nMicroInstructions; }
+        std::stable_sort(hotspots.begin(), hotspots.end(),
+            [](Row const&a, Row const&b) {
+                return a.statistics.nMicroInstructions
+                    > b.statistics.nMicroInstructions; });
+
+        std::vector<word_t> addresses{};
+        for (std::size_t j{0}; j < hotspots.size() && j < rows; ++j)
+            addresses.push_back(hotspots[j].address);
+        std::vector<std::string> const sources{SourceLocations::locate(
+            cs.debug.sourceMap, addresses)};
+
+        os << "hotspots: " << total << " micro-instructions executed at "
+           << hotspots.size() << " addresses\n"
+           << "   share    cum.  micro-instr.    executed  location\n";
+        uint_t cumulative{0};
+        for (std::size_t j{0}; j < sources.size(); ++j) {
+            Row const&row{hotspots[j]};
+            cumulative += row.statistics.nMicroInstructions;
+            os << Util::pad(Util::percent(
+                    row.statistics.nMicroInstructions, total), 8)
+               << Util::pad(Util::percent(cumulative, total), 8)
+               << Util::pad(std::to_string(
+                    row.statistics.nMicroInstructions), 14)
+               << Util::pad(std::to_string(row.statistics.nInstructions), 12)
+               << "  " << sources[j] << "\n";
+        }
+        if (hotspots.size() > rows)
+            os << "   (" << hotspots.size() - rows << " more addresses)\n";
+        os << std::flush;
+    }
+};
+
+#endif
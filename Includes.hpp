@@ -3,32 +3,56 @@
 
 #include <array>
 #include <bitset>
+#include <charconv>
 #include <climits>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <random>
-#include <regex>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
 #include "Types.hpp"
 #include "Util.cpp"
+#include "Memory.cpp"
 #include "RepresentationHandlers.cpp"
+#include "JIT.cpp"
+#include "MachineIO.cpp"
+#include "StackAnalysis.cpp"
+#include "SourceLocations.cpp"
+#include "CallGraph.cpp"
+#include "CacheModel.cpp"
+#include "BranchProfile.cpp"
 
 #include "Computation.cpp"
 #include "Log.cpp"
+#include "Syntax.cpp"
+#include "Linker.cpp"
+#include "ObjectFile.cpp"
+#include "SourceCache.cpp"
 #include "Parser.cpp"
+#include "Optimizer.cpp"
+#include "Hotspots.cpp"
+#include "ProfilerSummary.cpp"
+#include "CppTranslator.cpp"
 #include "UTF8.cpp"
 
 #endif
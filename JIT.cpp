@@ -0,0 +1,357 @@
+#ifndef JOY_ASSEMBLER__JIT_CPP
+#define JOY_ASSEMBLER__JIT_CPP
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__unix__)
+#define JOY_ASSEMBLER__JIT_AVAILABLE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Types.hpp"
+
+/* A native back end translating basic blocks of Joy instructions into
+   x86-64 machine code. Only register-level instructions, statically
+   verified constant-address memory accesses and jumps are translated; any
+   other instruction ends a block and is left to the interpreter. */
+namespace JIT {
+
+#ifdef JOY_ASSEMBLER__JIT_AVAILABLE
+    bool constexpr available{true};
+#else
+    bool constexpr available{false};
+#endif
+
+    /* how many times a program position has to be visited before a block
+       starting there is compiled */
+    uint_t constexpr hotThreshold{8};
+    /* upper bound on the number of Joy instructions in one block */
+    uint_t constexpr maximumBlockLength{64};
+
+    /* the machine state handed to compiled code; its layout is hard-coded
+       into the emitted instructions */
+    struct State {
+        word_t registerA, registerB, registerPC, registerSC;
+        byte_t *memory;
+    };
+    static_assert(offsetof(State, registerA) == 0);
+    static_assert(offsetof(State, registerB) == 4);
+    static_assert(offsetof(State, registerPC) == 8);
+    static_assert(offsetof(State, registerSC) == 12);
+    static_assert(offsetof(State, memory) == 16);
+
+    using code_t = void (*)(State *);
+
+    struct Block {
+        code_t code;
+        word_t begin, end;
+        ComputationStateStatistics statistics;
+        word_t highestUsedMemoryLocation;
+    };
+
+    /* Emits x86-64 machine code for a single block. While a block runs,
+       register A lives in eax, B in ecx, SC in edx and the memory base in
+       rsi; rdi points to the `State`. Only caller-saved registers are
+       used, so no stack frame is needed. */
+    class Emitter {
+        private:
+            std::vector<byte_t> code;
+
+        public: Emitter() :
+            code{}
+        {
+            /* mov eax, [rdi]; mov ecx, [rdi+4]; mov edx, [rdi+12] */
+            bytes({0x8b, 0x07, 0x8b, 0x4f, 0x04, 0x8b, 0x57, 0x0c});
+            /* mov rsi, [rdi+16] */
+            bytes({0x48, 0x8b, 0x77, 0x10});
+        }
+
+        public: std::vector<byte_t> const&getCode() const {
+            return code; }
+
+        public: void movA(word_t const imm) {
+            bytes({0xb8}); imm32(imm); }
+        public: void notA() {
+            bytes({0xf7, 0xd0}); }
+        public: void negA() {
+            bytes({0xf7, 0xd8}); }
+        public: void shlA(word_t const n) {
+            if (n >= 32)
+                bytes({0x31, 0xc0});
+            else
+                bytes({0xc1, 0xe0, static_cast<byte_t>(n)}); }
+        public: void shrA(word_t const n) {
+            if (n >= 32)
+                bytes({0x31, 0xc0});
+            else
+                bytes({0xc1, 0xe8, static_cast<byte_t>(n)}); }
+        public: void addAImm(word_t const imm) {
+            bytes({0x05}); imm32(imm); }
+        public: void subAImm(word_t const imm) {
+            bytes({0x2d}); imm32(imm); }
+        public: void addAB() {
+            bytes({0x01, 0xc8}); }
+        public: void subAB() {
+            bytes({0x29, 0xc8}); }
+        public: void andAB() {
+            bytes({0x21, 0xc8}); }
+        public: void orAB() {
+            bytes({0x09, 0xc8}); }
+        public: void xorAB() {
+            bytes({0x31, 0xc8}); }
+        public: void swapAB() {
+            bytes({0x91}); }
+        public: void loadSC() {
+            bytes({0x89, 0xd0}); }
+        public: void storeSC() {
+            bytes({0x89, 0xc2}); }
+
+        /* memory operands are `[rsi + disp32]`; the caller assures that
+           every address fits into a positive 32-bit displacement */
+        public: void loadA(word_t const m, MemoryMode const memoryMode) {
+            bytes({0x8b, 0x86}); imm32(m);
+            if (memoryMode == MemoryMode::BigEndian)
+                bytes({0x0f, 0xc8}); }
+        public: void loadB(word_t const m, MemoryMode const memoryMode) {
+            bytes({0x8b, 0x8e}); imm32(m);
+            if (memoryMode == MemoryMode::BigEndian)
+                bytes({0x0f, 0xc9}); }
+        public: void storeA(word_t const m, MemoryMode const memoryMode) {
+            if (memoryMode == MemoryMode::LittleEndian) {
+                bytes({0x89, 0x86}); imm32(m);
+                return; }
+            /* mov r8d, eax; bswap r8d; mov [rsi+m], r8d */
+            bytes({0x41, 0x89, 0xc0, 0x41, 0x0f, 0xc8, 0x44, 0x89, 0x86});
+            imm32(m); }
+        public: void storeB(word_t const m, MemoryMode const memoryMode) {
+            if (memoryMode == MemoryMode::LittleEndian) {
+                bytes({0x89, 0x8e}); imm32(m);
+                return; }
+            /* mov r8d, ecx; bswap r8d; mov [rsi+m], r8d */
+            bytes({0x41, 0x89, 0xc8, 0x41, 0x0f, 0xc8, 0x44, 0x89, 0x86});
+            imm32(m); }
+        public: void loadByteA(word_t const m) {
+            bytes({0x8a, 0x86}); imm32(m); }
+        public: void storeByteA(word_t const m) {
+            bytes({0x88, 0x86}); imm32(m); }
+
+        /* block exits; each one writes back PC and returns */
+        public: void exit(word_t const pc) {
+            /* mov dword [rdi+8], imm32 */
+            bytes({0xc7, 0x47, 0x08}); imm32(pc);
+            epilogue(); }
+        public: void exitToA() {
+            /* mov [rdi+8], eax */
+            bytes({0x89, 0x47, 0x08});
+            epilogue(); }
+        /* Jumps to `target` if the named condition on A holds, else falls
+           through to `pc`. The host flags are computed only here, right
+           before the single instruction reading them. */
+        public: bool exitIf(
+            InstructionName const name, word_t const target, word_t const pc
+        ) {
+            byte_t cmov{};
+            bool testEven{false};
+            switch (name) {
+                case InstructionName::JN:  cmov = 0x48; break;
+                case InstructionName::JNN: cmov = 0x49; break;
+                case InstructionName::JZ:  cmov = 0x44; break;
+                case InstructionName::JNZ: cmov = 0x45; break;
+                case InstructionName::JP:  cmov = 0x4f; break;
+                case InstructionName::JNP: cmov = 0x4e; break;
+                case InstructionName::JE:  cmov = 0x44; testEven = true; break;
+                case InstructionName::JNE: cmov = 0x45; testEven = true; break;
+
+                case InstructionName::NOP: case InstructionName::LDA:
+                case InstructionName::LDB: case InstructionName::STA:
+                case InstructionName::STB: case InstructionName::LIA:
+                case InstructionName::SIA: case InstructionName::LPC:
+                case InstructionName::SPC: case InstructionName::LYA:
+                case InstructionName::SYA: case InstructionName::JMP:
+                case InstructionName::CAL: case InstructionName::RET:
+                case InstructionName::PSH: case InstructionName::POP:
+                case InstructionName::LSA: case InstructionName::SSA:
+                case InstructionName::LSC: case InstructionName::SSC:
+                case InstructionName::MOV: case InstructionName::NOT:
+                case InstructionName::SHL: case InstructionName::SHR:
+                case InstructionName::INC: case InstructionName::DEC:
+                case InstructionName::NEG: case InstructionName::SWP:
+                case InstructionName::ADD: case InstructionName::SUB:
+                case InstructionName::AND: case InstructionName::OR:
+                case InstructionName::XOR: case InstructionName::GET:
+                case InstructionName::GTC: case InstructionName::PTU:
+                case InstructionName::PTS: case InstructionName::PTB:
+                case InstructionName::PTC: case InstructionName::RND:
+                case InstructionName::HLT:
+                    return false;
+            }
+
+            /* mov r8d, pc; mov r9d, target */
+            bytes({0x41, 0xb8}); imm32(pc);
+            bytes({0x41, 0xb9}); imm32(target);
+            if (testEven)
+                /* test al, 1 */
+                bytes({0xa8, 0x01});
+            else
+                /* test eax, eax */
+                bytes({0x85, 0xc0});
+            /* cmovcc r8d, r9d; mov [rdi+8], r8d */
+            bytes({0x45, 0x0f, cmov, 0xc1, 0x44, 0x89, 0x47, 0x08});
+            epilogue();
+            return true;
+        }
+
+        private: void epilogue() {
+            /* mov [rdi], eax; mov [rdi+4], ecx; mov [rdi+12], edx; ret */
+            bytes({0x89, 0x07, 0x89, 0x4f, 0x04, 0x89, 0x57, 0x0c, 0xc3}); }
+
+        private: void bytes(std::initializer_list<byte_t> const bs) {
+            code.insert(code.end(), bs); }
+
+        private: void imm32(word_t const w) {
+            for (std::size_t j{0}; j < 4; ++j)
+                code.push_back(static_cast<byte_t>((w >> (8*j)) & 0xff)); }
+    };
+
+    /* Executable memory obtained via `mmap`, handed out in chunks. Pages
+       are only writable whilst code is being copied into them. */
+    class CodeBuffer {
+        private:
+            static std::size_t constexpr chunkSize{1 << 16};
+            std::vector<byte_t *> chunks;
+            std::size_t used;
+
+        public: CodeBuffer() :
+            chunks{},
+            used{chunkSize}
+        { ; }
+
+        public: CodeBuffer(CodeBuffer const&) = delete;
+        public: CodeBuffer &operator=(CodeBuffer const&) = delete;
+        public: CodeBuffer(CodeBuffer &&other) :
+            chunks{std::move(other.chunks)},
+            used{other.used}
+        {
+            other.chunks.clear();
+            other.used = chunkSize; }
+
+        public: ~CodeBuffer() {
+            release(); }
+
+        public: void release() {
+#ifdef JOY_ASSEMBLER__JIT_AVAILABLE
+            for (byte_t *chunk : chunks)
+                munmap(chunk, chunkSize);
+#endif
+            chunks.clear();
+            used = chunkSize; }
+
+        public: std::optional<code_t> install(std::vector<byte_t> const&code) {
+#ifdef JOY_ASSEMBLER__JIT_AVAILABLE
+            if (code.size() > chunkSize)
+                return std::nullopt;
+
+            if (used + code.size() > chunkSize) {
+                void *chunk{mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+                if (chunk == MAP_FAILED)
+                    return std::nullopt;
+                chunks.push_back(static_cast<byte_t *>(chunk));
+                used = 0;
+            } else if (mprotect(chunks.back(), chunkSize,
+                PROT_READ | PROT_WRITE) != 0)
+                return std::nullopt;
+
+            byte_t *const destination{chunks.back() + used};
+            std::memcpy(destination, code.data(), code.size());
+            used += code.size();
+
+            if (mprotect(chunks.back(), chunkSize, PROT_READ | PROT_EXEC) != 0)
+                return std::nullopt;
+
+            return std::make_optional(reinterpret_cast<code_t>(destination));
+#else
+            (void) code;
+            return std::nullopt;
+#endif
+        }
+    };
+
+    /* Blocks keyed by their first program position, together with the
+       visit counts of positions not yet compiled. */
+    class Cache {
+        private:
+            std::vector<Block> blocks;
+            std::vector<int32_t> blockAt;
+            std::vector<uint8_t> heat;
+            CodeBuffer codeBuffer;
+            /* range of memory covered by any compiled block */
+            word_t lowest, highest;
+
+        public: Cache() :
+            blocks{},
+            blockAt{},
+            heat{},
+            codeBuffer{},
+            lowest{1}, highest{0}
+        { ; }
+
+        public: Cache(Cache &&) = default;
+
+        public: Block const*lookup(word_t const pc) const {
+            if (pc >= blockAt.size() || blockAt[pc] < 0)
+                return nullptr;
+            return &blocks[blockAt[pc]]; }
+
+        /* returns `true` once `pc` is hot enough to be compiled */
+        public: bool visit(word_t const pc) {
+            if (pc >= heat.size()) {
+                heat.resize(static_cast<std::size_t>(pc)+1, 0);
+                blockAt.resize(static_cast<std::size_t>(pc)+1, -1); }
+            if (heat[pc] > hotThreshold)
+                return false;
+            return ++heat[pc] == hotThreshold; }
+
+        /* remembers that compiling at `pc` was not possible */
+        public: void reject(word_t const pc) {
+            heat[pc] = hotThreshold + 1; }
+
+        public: Block const*insert(
+            std::vector<byte_t> const&code,
+            word_t const begin, word_t const end,
+            ComputationStateStatistics const&statistics,
+            word_t const highestUsedMemoryLocation
+        ) {
+            std::optional<code_t> oCode{codeBuffer.install(code)};
+            if (!oCode.has_value()) {
+                reject(begin);
+                return nullptr; }
+
+            blockAt[begin] = static_cast<int32_t>(blocks.size());
+            blocks.push_back(Block{oCode.value(), begin, end, statistics,
+                highestUsedMemoryLocation});
+            if (lowest > highest) {
+                lowest = begin;
+                highest = end-1; }
+            lowest = std::min(lowest, begin);
+            highest = std::max(highest, end-1);
+            return &blocks.back(); }
+
+        /* drops every block if any of the `width` bytes at `m` lies within
+           compiled code */
+        public: void invalidate(word_t const m, word_t const width=1) {
+            if (m+(width-1) < lowest || m > highest)
+                return;
+            blocks.clear();
+            std::fill(blockAt.begin(), blockAt.end(), -1);
+            std::fill(heat.begin(), heat.end(), 0);
+            codeBuffer.release();
+            lowest = 1;
+            highest = 0; }
+    };
+}
+
+#endif
@@ -8,6 +8,24 @@ static_assert(sizeof (int64_t) == sizeof (long long int));
 static_assert(sizeof (std::size_t) >= sizeof (uint32_t));
 static_assert(sizeof (uint_t) >= sizeof (std::size_t));
 
+/* how many rows `arg` asks a report for, being either `<report>` (twenty
+   rows) or `<report>=<rows>`; none if it asks for anything else */
+std::optional<std::size_t> rowsArgument(
+    std::string const&arg, std::string const&report
+) {
+    if (arg == report)
+        return std::make_optional(std::size_t{20});
+    if (arg.rfind(report + "=", 0) != 0)
+        return std::nullopt;
+    std::size_t rows{0};
+    char const*const end{arg.data() + arg.size()};
+    auto const[ptr, ec]{std::from_chars(arg.data() + report.size() + 1, end,
+        rows)};
+    if (ec != std::errc{} || ptr != end)
+        return std::nullopt;
+    return std::make_optional(rows);
+}
+
 int main(int const argc, char const*argv[]) {
     std::ios_base::sync_with_stdio(false);
 
@@ -17,29 +35,183 @@ int main(int const argc, char const*argv[]) {
     }
 
     try {
+        std::filesystem::path const filepath{
+            std::filesystem::current_path() / std::string{argv[1]}};
+        /* assembled programs are loaded without parsing */
+        bool const isObjectFile{filepath.extension() == ObjectFile::extension};
+        bool const isModule{
+            filepath.extension() == ObjectFile::moduleExtension};
+
+        /* modules are compiled or linked before any other argument */
+        std::optional<std::filesystem::path> oCompileTo{std::nullopt};
+        std::vector<std::filesystem::path> linked{};
+        std::vector<std::string> args{};
+        for (int j{2}; j < argc; ++j) {
+            std::string const arg{argv[j]};
+            if (arg == "compile")
+                oCompileTo = std::filesystem::path{argv[1]}
+                    .replace_extension(ObjectFile::moduleExtension);
+            else if (arg.rfind("compile=", 0) == 0)
+                oCompileTo = arg.substr(8);
+            else if (arg.rfind("link=", 0) == 0)
+                linked.push_back(std::filesystem::current_path()
+                    / arg.substr(5));
+            else
+                args.push_back(arg);
+        }
+
+        auto const module{[](std::filesystem::path const&path) {
+            if (path.extension() == ObjectFile::moduleExtension)
+                return std::make_optional(ObjectFile::loadModule(path));
+            return Parser{}.compile(path); }};
+
+        if (oCompileTo.has_value()) {
+            if (isObjectFile || isModule) {
+                std::cerr << "only source files can be compiled" << std::endl;
+                return EXIT_FAILURE; }
+            std::optional<Module> const oModule{Parser{}.compile(filepath)};
+            if (!oModule.has_value()) {
+                std::cerr << "parsing failed" << std::endl;
+                return EXIT_FAILURE; }
+            ObjectFile::write(oCompileTo.value(), oModule.value());
+            return EXIT_SUCCESS; }
+
+        bool const doLink{isModule || !linked.empty()};
+        auto const link{[&]() -> std::optional<ComputationState> {
+            std::vector<Module> modules{};
+            linked.insert(linked.begin(), filepath);
+            for (std::filesystem::path const&path : linked) {
+                std::optional<Module> oModule{module(path)};
+                if (!oModule.has_value())
+                    return std::nullopt;
+                modules.push_back(std::move(oModule.value())); }
+            return Linker::link(modules); }};
+
         Parser parser{};
-        std::optional<ComputationState> oCS{parser.parse(
-            std::filesystem::current_path() / std::string{argv[1]})};
+        std::optional<ComputationState> oCS{isObjectFile
+            ? std::optional<ComputationState>{ObjectFile::load(filepath)}
+            : doLink ? link() : parser.parse(filepath)};
 
         if (!oCS.has_value()) {
-            std::cerr << "parsing failed" << std::endl;
+            std::cerr << (doLink ? "linking failed" : "parsing failed")
+                << std::endl;
             return EXIT_FAILURE;
         }
         ComputationState cs{std::move(oCS.value())};
 
-        if (argc > 2 && std::string{argv[2]} != "memory-dump") {
-            if (!parser.commandlineArg(cs, std::string{argv[2]})) {
+        bool doMemoryDump{false}, doEmitCpp{false};
+        bool doOptimize{false}, doReportOptimization{false};
+        /* how many of the hottest source lines to report */
+        std::optional<std::size_t> oHotspots{std::nullopt};
+        std::optional<std::size_t> oBranches{std::nullopt};
+        std::optional<std::filesystem::path> oAssembleTo{std::nullopt};
+        std::optional<std::filesystem::path> oCallGraphTo{std::nullopt};
+        for (std::string const&arg : args) {
+            if (arg == "memory-dump") {
+                doMemoryDump = true;
+                continue; }
+            if (arg == "emit-cpp") {
+                doEmitCpp = true;
+                continue; }
+            if (arg == "optimize" || arg == "optimize-report") {
+                doOptimize = true;
+                doReportOptimization |= arg == "optimize-report";
+                continue; }
+            if (std::optional<std::size_t> const oRows{
+                rowsArgument(arg, "hotspots")}; oRows.has_value()) {
+                oHotspots = oRows;
+                cs.debug.doCountExecutions = true;
+                continue; }
+            if (arg == "profiler=table" || arg == "profiler=json"
+                || arg == "profiler=hits"
+            ) {
+                cs.debug.profilerOutput = arg == "profiler=table"
+                    ? ProfilerOutput::Table : arg == "profiler=json"
+                    ? ProfilerOutput::JSON : ProfilerOutput::Hits;
+                continue; }
+            if (arg == "cache-model") {
+                cs.modelCaches(CacheModel::Configuration{});
+                continue; }
+            if (arg.rfind("cache-model=", 0) == 0) {
+                cs.modelCaches(CacheModel::load(arg.substr(12)));
+                continue; }
+            if (arg == "call-graph") {
+                oCallGraphTo = std::filesystem::path{argv[1]}
+                    .replace_extension(".folded");
+                cs.debug.doProfileCalls = true;
+                continue; }
+            if (arg.rfind("call-graph=", 0) == 0) {
+                oCallGraphTo = arg.substr(11);
+                cs.debug.doProfileCalls = true;
+                continue; }
+            if (std::optional<std::size_t> const oRows{
+                rowsArgument(arg, "branches")}; oRows.has_value()) {
+                oBranches = oRows;
+                cs.debug.doProfileBranches = true;
+                continue; }
+            if (arg == "assemble") {
+                oAssembleTo = std::filesystem::path{argv[1]}
+                    .replace_extension(ObjectFile::extension);
+                continue; }
+            if (arg.rfind("assemble=", 0) == 0) {
+                oAssembleTo = arg.substr(9);
+                continue; }
+            if (!parser.commandlineArg(cs, arg)) {
                 std::cerr << "unknown commandline argument" << std::endl;
                 return EXIT_FAILURE;
             }
         }
 
-        if (argc > 2 && std::string{argv[2]} == "memory-dump") {
-            do cs.memoryDump(); while (cs.step()); cs.memoryDump();
-            return EXIT_SUCCESS;
-        }
+        Optimizer optimizer{};
+        if (doOptimize && !optimizer.optimize(cs))
+            doReportOptimization = false;
+
+        if (oAssembleTo.has_value()) {
+            ObjectFile::write(oAssembleTo.value(), cs);
+            return EXIT_SUCCESS; }
+
+        if (doEmitCpp)
+            return CppTranslator{cs}.translate(std::cout, argv[1])
+                ? EXIT_SUCCESS : EXIT_FAILURE;
+
+        StopReason reason{StopReason::BudgetExhausted};
+        if (doMemoryDump) {
+            do cs.memoryDump();
+            while ((reason = cs.run(1)) == StopReason::BudgetExhausted);
+            if (reason != StopReason::Fault)
+                cs.memoryDump();
+        } else if (doReportOptimization)
+            reason = optimizer.run(cs);
+        else
+            do reason = cs.run(std::numeric_limits<uint_t>::max());
+            while (
+                reason == StopReason::BudgetExhausted
+                || reason == StopReason::ProfilerBoundary);
 
-        do cs.visualize(); while (cs.step());
+        if (!cs.getProfilerRegions().empty() && !cs.embedsProfilerOutput()) {
+            if (cs.debug.profilerOutput == ProfilerOutput::Table)
+                ProfilerSummary::table(std::clog, cs.getProfilerRegions());
+            if (cs.debug.profilerOutput == ProfilerOutput::JSON)
+                ProfilerSummary::json(std::clog, cs.getProfilerRegions()); }
+        if (cs.cacheModel().has_value())
+            cs.cacheModel()->report(std::clog, cs.getStatistics());
+        if (oHotspots.has_value())
+            Hotspots::report(std::clog, cs, oHotspots.value());
+        if (oBranches.has_value())
+            cs.branchProfile().report(std::clog, cs.debug.sourceMap,
+                oBranches.value());
+        if (oCallGraphTo.has_value()) {
+            cs.callGraph().report(std::clog, cs.debug.sourceMap);
+            std::ofstream os{oCallGraphTo.value()};
+            cs.callGraph().writeFolded(os, cs.debug.sourceMap);
+            if (!os)
+                throw std::runtime_error{"could not write "
+                    + oCallGraphTo.value().string()}; }
+
+        if (reason == StopReason::Fault) {
+            std::cerr << "error: " << cs.getFaultMessage() << std::endl;
+            return EXIT_FAILURE;
+        }
     } catch (std::runtime_error const&e) {
         std::cerr << "error: " << e.what() << std::endl;
         return EXIT_FAILURE;
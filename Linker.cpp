@@ -0,0 +1,247 @@
+#ifndef JOY_ASSEMBLER__LINKER_CPP
+#define JOY_ASSEMBLER__LINKER_CPP
+
+#include "Includes.hpp"
+
+/* A separately assembled source file (see `Parser::compile`), laid out as
+   if placed at address zero. Each of its labels is exported; an argument
+   `@label` naming a label the module does not define is imported. */
+struct Module {
+    struct Relocation {
+        /* the instruction whose argument is patched */
+        word_t address;
+        /* the imported label (without `@`); without one, the argument is
+           an address inside the module and moves with it */
+        std::optional<std::string> symbol;
+    };
+
+    /* pragmas; only the first module's take effect when linking */
+    MemoryMode memoryMode{MemoryMode::LittleEndian};
+    bool staticProgram{true}, staticStackCheck{true};
+    bool memoryIsDynamic{false}, embedProfilerOutput{false};
+    std::optional<word_t> memorySize{std::nullopt};
+    std::optional<word_t> rngSeed{std::nullopt};
+
+    std::vector<byte_t> image{};
+    std::optional<SemanticMap> oSemantics{std::nullopt};
+    std::vector<std::tuple<std::string, word_t>> exports{};
+    std::vector<Relocation> relocations{};
+    std::vector<std::tuple<word_t, bool, std::string>> profiler{};
+    std::optional<std::tuple<word_t, word_t>> stack{std::nullopt};
+    bool haltInstructionWasUsed{false}, stackInstructionWasUsed{false};
+    SourceMap sourceMap{};
+
+    std::string name() const {
+        return sourceMap.files.empty() ? std::string{"(unnamed module)"}
+            : sourceMap.files.front().string(); }
+};
+
+/* Lays modules out one after another, the first one at address zero, and
+   patches every relocated argument. The linked program is checked like a
+   program assembled from a single source: statically, for a halt
+   instruction and for a stack. */
+class Linker {
+    public: static std::optional<ComputationState> link(
+        std::vector<Module> const&modules
+    ) {
+        if (modules.empty()) {
+            error("no modules to link");
+            return std::nullopt; }
+        Module const&main{modules.front()};
+
+        std::vector<word_t> bases{};
+        uint_t size{0};
+        for (Module const&module : modules) {
+            bases.push_back(static_cast<word_t>(size));
+            size += module.image.size();
+            if (size > std::numeric_limits<word_t>::max()) {
+                error("linked program exceeds the address space");
+                return std::nullopt; }
+
+            if (module.memoryMode != main.memoryMode) {
+                error(module.name() + ": memory mode differs from "
+                    + main.name());
+                return std::nullopt; }
+            if (main.staticProgram && !module.oSemantics.has_value()) {
+                error(module.name() + ": not a static program, unlike "
+                    + main.name());
+                return std::nullopt; }
+        }
+
+        /* an exported label's address; `std::nullopt` when ambiguous */
+        std::unordered_map<std::string, std::optional<word_t>> exported{};
+        for (std::size_t j{0}; j < modules.size(); ++j)
+            for (auto const&[label, address] : modules[j].exports) {
+                auto const[it, inserted]{exported.try_emplace(label,
+                    std::make_optional(bases[j] + address))};
+                if (!inserted)
+                    it->second = std::nullopt; }
+
+        word_t const memorySize{main.memorySize.value_or(
+            static_cast<word_t>(size))};
+        if (memorySize < size) {
+            error("memory size smaller than minimal required");
+            return std::nullopt; }
+
+        std::optional<SemanticMap> oSemantics{std::nullopt};
+        if (main.staticProgram) {
+            oSemantics.emplace();
+            oSemantics.value().reserve(static_cast<std::size_t>(size));
+            for (Module const&module : modules) {
+                SemanticMap const&semantics{module.oSemantics.value()};
+                for (std::size_t m{0}; m < semantics.size(); ++m)
+                    oSemantics.value().push_back(semantics[m]); }
+        }
+
+        std::vector<std::vector<std::tuple<bool, std::string>>> profiler{};
+        for (std::size_t j{0}; j < modules.size(); ++j)
+            for (auto const&[m, doStart, msg] : modules[j].profiler) {
+                if (m > modules[j].image.size()) {
+                    error(modules[j].name() + ": profiler directive beyond "
+                        "the module");
+                    return std::nullopt; }
+                std::size_t const at{std::size_t{bases[j]} + m};
+                if (profiler.size() < at+1)
+                    profiler.resize(at+1);
+                profiler[at].emplace_back(doStart, msg); }
+        if (!profiler.empty() && !main.staticProgram) {
+            error("incompatible pragmas: using the profiler forbids "
+                "'pragma_static-program := false'");
+            return std::nullopt; }
+
+        Util::rng_t rng{};
+        if (main.rngSeed.has_value())
+            rng.seed(main.rngSeed.value());
+
+        ComputationState cs{memorySize, main.memoryIsDynamic, main.memoryMode,
+            rng, profiler, main.embedProfilerOutput, std::move(oSemantics)};
+
+        SourceMap &sourceMap{cs.debug.sourceMap};
+        bool haltInstructionWasUsed{false}, stackInstructionWasUsed{false};
+        std::optional<std::tuple<word_t, word_t>> stack{std::nullopt};
+        for (std::size_t j{0}; j < modules.size(); ++j) {
+            Module const&module{modules[j]};
+            word_t const base{bases[j]};
+            cs.memory.copyIn(base, module.image.data(), module.image.size());
+
+            haltInstructionWasUsed |= module.haltInstructionWasUsed;
+            stackInstructionWasUsed |= module.stackInstructionWasUsed;
+            if (module.stack.has_value()) {
+                if (stack.has_value()) {
+                    error(module.name() + ": a stack was already defined");
+                    return std::nullopt; }
+                auto const[begin, end]{module.stack.value()};
+                stack = std::make_tuple(base + begin, base + end); }
+
+            uint32_t const fileOffset{static_cast<uint32_t>(
+                sourceMap.files.size())};
+            sourceMap.files.insert(sourceMap.files.end(),
+                module.sourceMap.files.begin(), module.sourceMap.files.end());
+            for (auto const&[m, label] : module.sourceMap.labels)
+                sourceMap.labels.emplace_back(base + m, label);
+
+            /* instructions are stored anew, such that static analysis
+               sees the whole program */
+            auto relocation{module.relocations.begin()};
+            for (SourceLine ln : module.sourceMap.lines) {
+                ln.address += base;
+                ln.file += fileOffset;
+                sourceMap.lines.push_back(ln);
+                if (!ln.instruction)
+                    continue;
+
+                word_t const m{ln.address - base};
+                if (m + std::size_t{5} > module.image.size()) {
+                    error(sourceMap, ln, "instruction outside of module");
+                    return std::nullopt; }
+                word_t argument{0};
+                for (word_t k{0}; k < 4; ++k)
+                    argument |= static_cast<word_t>(module.image[m+1+k])
+                        << 8*(main.memoryMode == MemoryMode::LittleEndian
+                            ? k : 3-k);
+
+                while (relocation != module.relocations.end()
+                    && relocation->address < m)
+                    ++relocation;
+                if (relocation != module.relocations.end()
+                    && relocation->address == m
+                ) {
+                    if (!relocation->symbol.has_value())
+                        argument += base;
+                    else {
+                        std::string const&label{relocation->symbol.value()};
+                        auto const it{exported.find(label)};
+                        if (it == exported.end()) {
+                            error(sourceMap, ln, undefinedLabel(label,
+                                exported));
+                            return std::nullopt; }
+                        if (!it->second.has_value()) {
+                            error(sourceMap, ln, "label @" + label
+                                + " is exported by more than one module");
+                            return std::nullopt; }
+                        argument = it->second.value(); }
+                }
+
+                Instruction const instruction{
+                    InstructionNameRepresentationHandler::fromByteCode(
+                        module.image[m]), argument};
+                try {
+                    cs.storeInstruction(ln.address, instruction);
+                } catch (std::runtime_error const&e) {
+                    error(sourceMap, ln, std::string{"failed to store "
+                        "instruction: "} + e.what());
+                    return std::nullopt;
+                }
+            }
+        }
+
+        std::sort(sourceMap.labels.begin(), sourceMap.labels.end());
+
+        if (!haltInstructionWasUsed) {
+            error("no halt instruction was used");
+            return std::nullopt; }
+        if (main.staticStackCheck && stackInstructionWasUsed
+            && !stack.has_value()
+        ) {
+            error("stack instructions are used yet no stack was defined");
+            return std::nullopt; }
+        if (stack.has_value()) {
+            cs.debug.stackBoundaries = stack;
+            cs.registerSC = std::get<0>(stack.value()); }
+
+        std::optional<std::string> const oWarning{cs.stackWarning()};
+        if (oWarning.has_value())
+            error("warning: " + oWarning.value());
+
+        return std::make_optional(std::move(cs));
+    }
+
+    private: static std::string undefinedLabel(
+        std::string const&label,
+        std::unordered_map<std::string, std::optional<word_t>> const&exported
+    ) {
+        std::vector<std::string> labels{};
+        for (auto const&[lbl, _] : exported)
+            labels.push_back(lbl);
+        std::vector<std::string> const closest{
+            Util::closestByLevenshteinDistanceTo(labels, label, 3)};
+        std::string msg{"label @" + label + " is neither defined nor "
+            "exported by any module; did you possibly mean one of the "
+            "following exported labels?"};
+        for (std::size_t j{0}; j < closest.size(); ++j)
+            msg += "\n    " + std::to_string(j+1) + ") @" + closest[j];
+        if (closest.empty())
+            msg += "\n    (no labels have been exported)";
+        return msg; }
+
+    private: static void error(
+        SourceMap const&sourceMap, SourceLine const&ln, std::string const&msg
+    ) {
+        std::cerr << "linking: file " << sourceMap.files.at(ln.file)
+                  << ", ln " << ln.line << ": " << msg << std::endl; }
+
+    private: static void error(std::string const&msg) {
+        std::cerr << "linking: " << msg << std::endl; }
+};
+
+#endif
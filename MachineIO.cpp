@@ -0,0 +1,257 @@
+#ifndef JOY_ASSEMBLER__MACHINE_IO_CPP
+#define JOY_ASSEMBLER__MACHINE_IO_CPP
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "Types.hpp"
+#include "UTF8.cpp"
+#include "Util.cpp"
+
+/* The machine's view of the outside world: `PTU`, `PTS`, `PTB` and `PTC`
+   write to a `Sink`, `GET` and `GTC` read from a `Source`. */
+namespace MachineIO {
+
+    /* when buffered output is handed to its stream, besides whenever a
+       computation stops running */
+    enum class FlushPolicy : uint8_t { Newline, Input, Halt };
+
+    class Sink {
+        public: virtual ~Sink() = default;
+
+        public: virtual void put(std::string_view const text) = 0;
+        /* about to block on input */
+        public: virtual void awaitInput() { ; }
+        public: virtual void flush() { ; }
+
+        public: void putRune(UTF8::rune_t const rune) {
+            if (rune <= 0x7f) {
+                char const c{static_cast<char>(rune)};
+                put(std::string_view{&c, 1});
+                return; }
+
+            UTF8::Encoder encoder{};
+            encoder.encode(rune);
+            auto const[bytes, ok]{encoder.finish()};
+            if (ok)
+                put(std::string_view{
+                    reinterpret_cast<char const*>(bytes.data()), bytes.size()});
+        }
+
+        public: void putUnsigned(word_t const w) {
+            char buf[16];
+            auto const[end, _]{std::to_chars(buf, buf + sizeof buf, w)};
+            put(std::string_view{buf, static_cast<std::size_t>(end - buf)}); }
+
+        public: void putSigned(int32_t const n) {
+            char buf[16];
+            auto const[end, _]{std::to_chars(buf, buf + sizeof buf, n)};
+            put(std::string_view{buf, static_cast<std::size_t>(end - buf)}); }
+    };
+
+    class Source {
+        public: virtual ~Source() = default;
+
+        /* whether the user is to be prompted before each read */
+        public: virtual bool interactive() const = 0;
+        /* `std::nullopt` asks for the number to be read again */
+        public: virtual std::optional<word_t> getNumber() = 0;
+        public: virtual UTF8::rune_t getRune() = 0;
+    };
+
+    /* Collects output and hands it to a stream according to a
+       `FlushPolicy`; at most `capacity` bytes are held back. */
+    class StreamSink : public Sink {
+        private:
+            static std::size_t constexpr capacity{1 << 16};
+
+            std::ostream &out;
+            FlushPolicy policy;
+            std::string buffer;
+
+        public: StreamSink(std::ostream &out, FlushPolicy const policy) :
+            out{out},
+            policy{policy},
+            buffer{}
+        {
+            buffer.reserve(capacity); }
+
+        public: ~StreamSink() override {
+            flush(); }
+
+        public: void put(std::string_view const text) override {
+            buffer.append(text);
+            if (buffer.size() >= capacity || (policy == FlushPolicy::Newline
+                && text.find('\n') != std::string_view::npos))
+                flush(); }
+
+        public: void awaitInput() override {
+            if (policy != FlushPolicy::Halt)
+                flush(); }
+
+        public: void flush() override {
+            out.write(buffer.data(), static_cast<std::streamsize>(
+                buffer.size()));
+            buffer.clear();
+            out.flush(); }
+    };
+
+    /* Keeps all output, e.g. for a host program embedding a machine. */
+    class MemorySink : public Sink {
+        private:
+            std::string buffer;
+
+        public: MemorySink() :
+            buffer{}
+        { ; }
+
+        public: void put(std::string_view const text) override {
+            buffer.append(text); }
+
+        public: std::string const&str() const {
+            return buffer; }
+    };
+
+    /* Reads from a terminal: one number per line, prompting again for
+       lines which do not hold a number. */
+    class ConsoleSource : public Source {
+        private:
+            std::istream &in;
+
+        public: ConsoleSource(std::istream &in) :
+            in{in}
+        { ; }
+
+        public: bool interactive() const override {
+            return true; }
+
+        public: std::optional<word_t> getNumber() override {
+            std::string line;
+            if (!std::getline(in, line))
+                throw std::runtime_error{"GET: end of input"};
+            return Util::stringToOptionalUInt32(line); }
+
+        public: UTF8::rune_t getRune() override {
+            UTF8::Decoder decoder{};
+            while (decoder.decode(static_cast<UTF8::byte_t>(in.get())))
+                ;
+            auto [runes, ok] = decoder.finish();
+            if (!ok || runes.size() != 1)
+                return UTF8::ERROR_RUNE;
+            return runes.front(); }
+    };
+
+    /* A prompt-less input tape of whitespace-separated numbers and raw
+       characters, read from a stream in large chunks. Malformed numbers
+       and reading past the tape's end are errors. */
+    class TapeSource : public Source {
+        private:
+            static std::size_t constexpr chunkSize{1 << 16};
+
+            std::unique_ptr<std::istream> file;
+            std::istream *in;
+            std::string buffer;
+            std::size_t position;
+
+        public: TapeSource(std::istream &in) :
+            file{nullptr},
+            in{&in},
+            buffer{},
+            position{0}
+        { ; }
+
+        protected: TapeSource(std::string tape) :
+            file{nullptr},
+            in{nullptr},
+            buffer{std::move(tape)},
+            position{0}
+        { ; }
+
+        /* a tape read from a file, if it can be opened */
+        public: static std::unique_ptr<TapeSource> open(
+            std::filesystem::path const&filepath
+        ) {
+            auto file{std::make_unique<std::ifstream>(
+                filepath, std::ios::binary)};
+            if (!*file)
+                return nullptr;
+            std::unique_ptr<TapeSource> tape{
+                std::make_unique<TapeSource>(*file)};
+            tape->file = std::move(file);
+            return tape; }
+
+        public: bool interactive() const override {
+            return false; }
+
+        public: std::optional<word_t> getNumber() override {
+            while (available() && isSpace(buffer[position]))
+                ++position;
+            if (!available())
+                throw std::runtime_error{"GET: end of input tape"};
+
+            std::size_t end{position};
+            while ((end < buffer.size() || refill(end))
+                && !isSpace(buffer[end]))
+                ++end;
+
+            std::optional<word_t> const oN{Util::charsToOptionalUInt32(
+                buffer.data() + position, buffer.data() + end)};
+            if (!oN.has_value())
+                throw std::runtime_error{"GET: malformed number on input "
+                    "tape: " + buffer.substr(position, end - position)};
+            position = end;
+            return oN; }
+
+        public: UTF8::rune_t getRune() override {
+            UTF8::Decoder decoder{};
+            do if (!available())
+                throw std::runtime_error{"GTC: end of input tape"};
+            while (decoder.decode(static_cast<UTF8::byte_t>(
+                buffer[position++])));
+            auto [runes, ok] = decoder.finish();
+            if (!ok || runes.size() != 1)
+                return UTF8::ERROR_RUNE;
+            return runes.front(); }
+
+        private: static bool isSpace(char const c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v'
+                || c == '\f' || c == '\r'; }
+
+        private: bool available() {
+            return position < buffer.size() || refill(position); }
+
+        /* Reads another chunk, dropping consumed input; `keep` is adjusted
+           to still index the same byte. */
+        private: bool refill(std::size_t &keep) {
+            if (in == nullptr || !*in)
+                return false;
+
+            buffer.erase(0, position);
+            keep -= position;
+            position = 0;
+
+            std::size_t const size{buffer.size()};
+            buffer.resize(size + chunkSize);
+            in->read(buffer.data() + size, chunkSize);
+            buffer.resize(size + static_cast<std::size_t>(in->gcount()));
+            return buffer.size() > size; }
+    };
+
+    /* An input tape held in memory, e.g. for a host program embedding a
+       machine. */
+    class MemorySource : public TapeSource {
+        public: MemorySource(std::string tape) :
+            TapeSource{std::move(tape)}
+        { ; }
+    };
+}
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef JOY_ASSEMBLER__MEMORY_CPP
+#define JOY_ASSEMBLER__MEMORY_CPP
+
+#include <algorithm>
+#include <array>
+#include <csetjmp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#if defined(__unix__) && UINTPTR_MAX > 0xffffffff
+#define JOY_ASSEMBLER__GUARDED_MEMORY_AVAILABLE
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Types.hpp"
+
+/* Turns faulting accesses to guarded memory into a `siglongjmp` back into
+   the running computation. Only faults inside the armed range are
+   handled; any other fault keeps its default behaviour. */
+namespace MemoryGuard {
+
+#ifdef JOY_ASSEMBLER__GUARDED_MEMORY_AVAILABLE
+    bool constexpr available{true};
+
+    inline byte_t const*armedBegin{nullptr}, *armedEnd{nullptr};
+    inline sigjmp_buf *armedTrap{nullptr};
+
+    inline void handler(int const signal, siginfo_t *const info, void *) {
+        byte_t const*const address{static_cast<byte_t const*>(info->si_addr)};
+        if (armedTrap != nullptr
+            && armedBegin <= address && address < armedEnd)
+            siglongjmp(*armedTrap, 1);
+
+        /* not a guarded access: returning re-executes the faulting
+           instruction under the default disposition */
+        struct sigaction action{};
+        action.sa_handler = SIG_DFL;
+        sigemptyset(&action.sa_mask);
+        sigaction(signal, &action, nullptr);
+    }
+
+    /* the handler is installed with `SA_NODEFER`, such that jumping out of
+       it leaves the signal mask untouched and `sigsetjmp` does not need to
+       save it */
+    inline bool install() {
+        static bool installed{false};
+        if (installed)
+            return true;
+
+        struct sigaction action{};
+        action.sa_sigaction = handler;
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGSEGV, &action, nullptr) != 0
+            || sigaction(SIGBUS, &action, nullptr) != 0)
+            return false;
+        return installed = true;
+    }
+
+    inline void arm(
+        sigjmp_buf &trap, byte_t const*const begin, byte_t const*const end
+    ) {
+        armedBegin = begin;
+        armedEnd = end;
+        armedTrap = &trap; }
+
+    inline void disarm() {
+        armedTrap = nullptr; }
+#else
+    bool constexpr available{false};
+#endif
+}
+
+/* Memory semantics packed into two bits per byte. Four consecutive
+   semantics can be read as a single byte, such that a word access is
+   validated by one comparison (see `word` and `pattern`). */
+class SemanticMap {
+    private:
+        /* always holds one more byte than needed, such that `word` can read
+           two bytes without a bounds check */
+        std::vector<byte_t> packed;
+        std::size_t length;
+
+    public: SemanticMap() :
+        packed(2, 0x00),
+        length{0}
+    { ; }
+
+    /* a map of `size` semantics from their packed representation, as
+       given by `packedData`; `packedSize(size)` bytes are read */
+    public: SemanticMap(byte_t const*const data, std::size_t const size) :
+        packed(data, data + packedSize(size)),
+        length{size}
+    { ; }
+
+    public: static std::size_t packedSize(std::size_t const size) {
+        return size/4 + 2; }
+    public: byte_t const*packedData() const {
+        return packed.data(); }
+
+    public: std::size_t size() const {
+        return length; }
+
+    public: void reserve(std::size_t const size) {
+        packed.reserve(packedSize(size)); }
+
+    public: void push_back(MemorySemantic const sem) {
+        packed[length >> 2] |= static_cast<byte_t>(
+            static_cast<byte_t>(sem) << 2*(length & 3));
+        if ((++length >> 2) + 2 > packed.size())
+            packed.push_back(0x00); }
+
+    public: MemorySemantic operator[](std::size_t const m) const {
+        return static_cast<MemorySemantic>(
+            (packed[m >> 2] >> 2*(m & 3)) & 0b11); }
+
+    /* the semantics of bytes `m` to `m+3`, byte `m+j` in bits `2j` and
+       `2j+1`; requires `m+3 < size()` */
+    public: byte_t word(std::size_t const m) const {
+        unsigned const window{static_cast<unsigned>(packed[m >> 2])
+            | static_cast<unsigned>(packed[(m >> 2) + 1]) << 8};
+        return static_cast<byte_t>(window >> 2*(m & 3)); }
+
+    /* the mask and value a `word` has to match for byte `m+j` to carry
+       `wordMemorySemantic[order[j]]`, if specified */
+    public: static std::tuple<byte_t, byte_t> pattern(
+        WordMemorySemantic const&wordMemorySemantic,
+        std::array<std::size_t, 4> const&order
+    ) {
+        byte_t mask{0x00}, value{0x00};
+        for (std::size_t j{0}; j < 4; ++j)
+            if (std::optional<MemorySemantic> const&oSem{
+                wordMemorySemantic[order[j]]}; oSem.has_value()
+            ) {
+                mask |= static_cast<byte_t>(0b11 << 2*j);
+                value |= static_cast<byte_t>(
+                    static_cast<byte_t>(oSem.value()) << 2*j); }
+        return std::make_tuple(mask, value); }
+};
+
+/* A machine's memory, in one of three layouts:
+   - contiguous, backed by a `std::vector`;
+   - guarded (see `guard`): placed at the very end of its committed pages
+     inside a reservation spanning the whole 32-bit address space, so every
+     out-of-bounds address hits an inaccessible page;
+   - sparse (dynamic memory): a two-level table of 4 KiB pages which are
+     allocated when first written to; untouched pages read as zero.
+   Contiguous and guarded memory are accessed through `operator[]` and
+   `data()`, sparse memory through `sparseLoad` and `sparseStore`; `read`
+   works for any layout. Static programs keep their memory semantics
+   alongside. */
+class Memory {
+    public:
+        static std::size_t constexpr pageBits{12};
+        static std::size_t constexpr pageSize{1 << pageBits};
+    private:
+        static std::size_t constexpr directoryBits{10};
+        static std::size_t constexpr directorySize{1 << directoryBits};
+        using page_t = std::array<byte_t, pageSize>;
+        using directory_t = std::array<std::unique_ptr<page_t>,
+            directorySize>;
+        static_assert(pageBits + 2*directoryBits == 32);
+
+        std::vector<byte_t> bytes;
+        byte_t *reservation;
+        std::size_t reservationSize;
+        std::vector<std::unique_ptr<directory_t>> directories;
+        bool sparse;
+        std::optional<SemanticMap> oSemantics;
+
+        byte_t *base;
+        std::size_t length;
+
+    public: Memory(
+        std::size_t const size, bool const sparse=false,
+        std::optional<SemanticMap> oSemantics=std::nullopt
+    ) :
+        bytes(sparse ? 0 : size, 0x00),
+        reservation{nullptr},
+        reservationSize{0},
+        directories{},
+        sparse{sparse},
+        oSemantics{std::move(oSemantics)},
+        base{sparse ? nullptr : bytes.data()},
+        length{size}
+    {
+        if (sparse)
+            directories.resize(directorySize); }
+
+    public: Memory(Memory const&) = delete;
+    public: Memory &operator=(Memory const&) = delete;
+    public: Memory(Memory &&other) :
+        bytes{std::move(other.bytes)},
+        reservation{other.reservation},
+        reservationSize{other.reservationSize},
+        directories{std::move(other.directories)},
+        sparse{other.sparse},
+        oSemantics{std::move(other.oSemantics)},
+        base{reservation != nullptr || sparse ? other.base : bytes.data()},
+        length{other.length}
+    {
+        other.reservation = nullptr;
+        other.reservationSize = 0;
+        other.base = nullptr;
+        other.length = 0; }
+
+    public: ~Memory() {
+#ifdef JOY_ASSEMBLER__GUARDED_MEMORY_AVAILABLE
+        if (reservation != nullptr)
+            munmap(reservation, reservationSize);
+#endif
+    }
+
+    public: std::size_t size() const {
+        return length; }
+    public: bool empty() const {
+        return length == 0; }
+
+    public: byte_t *data() {
+        return base; }
+    public: byte_t const*data() const {
+        return base; }
+
+    public: byte_t &operator[](std::size_t const m) {
+        return base[m]; }
+    public: byte_t const&operator[](std::size_t const m) const {
+        return base[m]; }
+
+    public: byte_t const*begin() const {
+        return base; }
+    public: byte_t const*end() const {
+        return base + length; }
+
+    public: void resize(std::size_t const size) {
+        if (reservation != nullptr)
+            throw std::runtime_error{"guarded memory cannot be resized"};
+        if (!sparse) {
+            bytes.resize(size, 0x00);
+            base = bytes.data(); }
+        length = size; }
+
+    public: bool isGuarded() const {
+        return reservation != nullptr; }
+    public: bool isSparse() const {
+        return sparse; }
+
+    public: bool hasSemantics() const {
+        return oSemantics.has_value(); }
+    public: SemanticMap const&semantics() const {
+        return oSemantics.value(); }
+
+    public: byte_t read(std::size_t const m) const {
+        return sparse ? sparseLoad(m) : base[m]; }
+
+    public: byte_t sparseLoad(std::size_t const m) const {
+        page_t const*const p{page(m)};
+        return p != nullptr ? (*p)[m & (pageSize-1)] : 0x00; }
+
+    public: void sparseStore(std::size_t const m, byte_t const b) {
+        touch(m)[m & (pageSize-1)] = b; }
+
+    /* a word's four bytes in memory order, assembled like a `memcpy` from
+       contiguous memory would */
+    public: word_t sparseLoad4(std::size_t const m) const {
+        word_t w{0};
+        if ((m & (pageSize-1)) <= pageSize-4) {
+            if (page_t const*const p{page(m)}; p != nullptr)
+                std::memcpy(&w, p->data() + (m & (pageSize-1)), sizeof w);
+            return w; }
+
+        byte_t bs[4]{sparseLoad(m), sparseLoad(m+1), sparseLoad(m+2),
+            sparseLoad(m+3)};
+        std::memcpy(&w, bs, sizeof w);
+        return w; }
+
+    public: void sparseStore4(std::size_t const m, word_t const w) {
+        if ((m & (pageSize-1)) <= pageSize-4) {
+            std::memcpy(touch(m).data() + (m & (pageSize-1)), &w, sizeof w);
+            return; }
+
+        byte_t bs[4];
+        std::memcpy(bs, &w, sizeof w);
+        for (std::size_t j{0}; j < 4; ++j)
+            sparseStore(m+j, bs[j]); }
+
+    /* bulk copies between memory at `m` and a buffer; sparse memory is
+       copied page by page, such that zeros destined for an unallocated
+       page leave it unallocated */
+    public: void copyIn(
+        std::size_t m, byte_t const*src, std::size_t n
+    ) {
+        if (!sparse) {
+            std::memcpy(base + m, src, n);
+            return; }
+        while (n > 0) {
+            std::size_t const chunk{std::min(n, pageSize - (m & (pageSize-1)))};
+            if (page(m) != nullptr || std::any_of(src, src + chunk,
+                [](byte_t const b) { return b != 0; }))
+                std::memcpy(touch(m).data() + (m & (pageSize-1)), src, chunk);
+            m += chunk; src += chunk; n -= chunk; }
+    }
+
+    public: void copyOut(
+        std::size_t m, byte_t *dst, std::size_t n
+    ) const {
+        if (!sparse) {
+            std::memcpy(dst, base + m, n);
+            return; }
+        while (n > 0) {
+            std::size_t const chunk{std::min(n, pageSize - (m & (pageSize-1)))};
+            if (page_t const*const p{page(m)}; p != nullptr)
+                std::memcpy(dst, p->data() + (m & (pageSize-1)), chunk);
+            else
+                std::memset(dst, 0, chunk);
+            m += chunk; dst += chunk; n -= chunk; }
+    }
+
+    /* the position of the last non-zero byte (or zero); sparse memory only
+       looks at allocated pages */
+    public: std::size_t lastNonZero() const {
+        if (!sparse) {
+            std::size_t m{length};
+            while (m > 1 && base[m-1] == 0)
+                --m;
+            return m > 0 ? m-1 : 0; }
+
+        for (std::size_t d{directorySize}; d-- > 0; ) {
+            if (!directories[d])
+                continue;
+            for (std::size_t q{directorySize}; q-- > 0; ) {
+                page_t const*const p{(*directories[d])[q].get()};
+                if (p == nullptr)
+                    continue;
+                for (std::size_t j{pageSize}; j-- > 0; )
+                    if ((*p)[j] != 0) {
+                        std::size_t const m{
+                            (d << directoryBits | q) << pageBits | j};
+                        return m < length ? m : 0; }
+            }
+        }
+        return 0; }
+
+    /* the addresses any access to guarded memory can reach, i.e. the
+       reservation */
+    public: byte_t const*guardedBegin() const {
+        return reservation; }
+    public: byte_t const*guardedEnd() const {
+        return reservation + reservationSize; }
+
+    private: page_t const*page(std::size_t const m) const {
+        std::unique_ptr<directory_t> const&d{
+            directories[(m >> (pageBits + directoryBits)) & (directorySize-1)]};
+        return d ? (*d)[(m >> pageBits) & (directorySize-1)].get() : nullptr; }
+
+    private: page_t &touch(std::size_t const m) {
+        std::unique_ptr<directory_t> &d{
+            directories[(m >> (pageBits + directoryBits)) & (directorySize-1)]};
+        if (!d)
+            d = std::make_unique<directory_t>();
+        std::unique_ptr<page_t> &p{(*d)[(m >> pageBits) & (directorySize-1)]};
+        if (!p)
+            p = std::make_unique<page_t>();
+        return *p; }
+
+    /* Moves the contents into a fresh reservation. Fails when the
+       platform does not support guarded memory or the reservation cannot
+       be made. */
+    public: bool guard() {
+#ifdef JOY_ASSEMBLER__GUARDED_MEMORY_AVAILABLE
+        if (reservation != nullptr)
+            return true;
+        if (sparse || !MemoryGuard::install())
+            return false;
+
+        std::size_t const page{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))};
+        std::size_t const committed{(length + page-1) / page * page};
+        /* every 32-bit address plus three bytes of a word access, rounded
+           up to a whole page */
+        std::size_t const size{committed - length + (std::size_t{1} << 32)
+            + page};
+
+        void *const r{mmap(nullptr, size, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+        if (r == MAP_FAILED)
+            return false;
+        if (committed > 0
+            && mprotect(r, committed, PROT_READ | PROT_WRITE) != 0) {
+            munmap(r, size);
+            return false; }
+
+        reservation = static_cast<byte_t *>(r);
+        reservationSize = size;
+        base = reservation + (committed - length);
+        if (length > 0)
+            std::memcpy(base, bytes.data(), length);
+        bytes = std::vector<byte_t>{};
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+#endif
@@ -0,0 +1,553 @@
+#ifndef JOY_ASSEMBLER__OBJECT_FILE_CPP
+#define JOY_ASSEMBLER__OBJECT_FILE_CPP
+
+#include "Includes.hpp"
+
+#if defined(__unix__)
+#define JOY_ASSEMBLER__MAPPED_FILES_AVAILABLE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Assembled programs (`.joyo` files) hold everything a `ComputationState`
+   holds after parsing, such that a program can be run again without
+   parsing its sources; modules (`.joym` files) hold a `Module` to be
+   linked. A file starts with the magic bytes `JOYO`, a format version, a
+   section count and a table of sections, each given as a tag, an offset
+   and a size. All numbers are little-endian. Sections:
+     - machine (programs): memory size, memory mode, whether memory is
+       dynamic, whether profiler output is embedded and the stack;
+     - module (modules): the pragmas, the stack and which instructions
+       were used;
+     - image: the initial memory up to its last non-zero byte (programs)
+       or in full (modules);
+     - semantics: the packed memory semantics of static programs;
+     - rng: the random number engine's state if it was seeded;
+     - profiler: each profiler directive's address, kind and message;
+     - source map: the source files, where each piece of memory was
+       assembled from and each label's address;
+     - exports and relocations (modules): each label's address and each
+       instruction whose argument is patched when linking. */
+class ObjectFile {
+    public:
+        static word_t constexpr version{2};
+        static char constexpr extension[]{".joyo"};
+        static char constexpr moduleExtension[]{".joym"};
+
+    private:
+        enum class Section : word_t {
+            Machine = 1, Image = 2, Semantics = 3, RNG = 4, Profiler = 5,
+            SourceMap = 6, Module = 7, Exports = 8, Relocations = 9
+        };
+        using Sections = std::vector<std::tuple<Section, std::string>>;
+
+        /* a file's contents, mapped into memory where possible */
+        class MappedFile {
+            private:
+                byte_t const*bytes;
+                std::size_t length;
+                bool mapped;
+                std::vector<byte_t> buffer;
+
+            public: MappedFile(std::filesystem::path const&filepath) :
+                bytes{nullptr},
+                length{0},
+                mapped{false},
+                buffer{}
+            {
+#ifdef JOY_ASSEMBLER__MAPPED_FILES_AVAILABLE
+                int const fd{::open(filepath.c_str(), O_RDONLY)};
+                if (fd < 0)
+                    throw std::runtime_error{"could not open object file: "
+                        + filepath.string()};
+                struct stat status;
+                if (fstat(fd, &status) == 0 && status.st_size > 0) {
+                    void *const p{mmap(nullptr,
+                        static_cast<std::size_t>(status.st_size), PROT_READ,
+                        MAP_PRIVATE, fd, 0)};
+                    if (p != MAP_FAILED) {
+                        bytes = static_cast<byte_t const*>(p);
+                        length = static_cast<std::size_t>(status.st_size);
+                        mapped = true; }
+                }
+                ::close(fd);
+                if (mapped)
+                    return;
+#endif
+                std::ifstream is{filepath, std::ios::binary};
+                if (!is)
+                    throw std::runtime_error{"could not open object file: "
+                        + filepath.string()};
+                buffer.assign(std::istreambuf_iterator<char>{is},
+                    std::istreambuf_iterator<char>{});
+                bytes = buffer.data();
+                length = buffer.size(); }
+
+            public: MappedFile(MappedFile const&) = delete;
+            public: MappedFile &operator=(MappedFile const&) = delete;
+
+            public: ~MappedFile() {
+#ifdef JOY_ASSEMBLER__MAPPED_FILES_AVAILABLE
+                if (mapped)
+                    munmap(const_cast<byte_t *>(bytes), length);
+#endif
+            }
+
+            public: byte_t const*data() const {
+                return bytes; }
+            public: std::size_t size() const {
+                return length; }
+        };
+
+    /* little-endian encoding, also used by `SourceCache` */
+    public:
+        class Writer {
+            private:
+                std::string bytes;
+
+            public: Writer() :
+                bytes{}
+            { ; }
+
+            public: void u8(byte_t const b) {
+                bytes.push_back(static_cast<char>(b)); }
+            public: void u32(word_t const w) {
+                for (std::size_t j{0}; j < 4; ++j)
+                    u8(static_cast<byte_t>(w >> 8*j)); }
+            public: void u64(uint_t const n) {
+                u32(static_cast<word_t>(n));
+                u32(static_cast<word_t>(n >> 32)); }
+            public: void raw(byte_t const*const data, std::size_t const n) {
+                bytes.append(reinterpret_cast<char const*>(data), n); }
+            public: void string(std::string const&s) {
+                u32(static_cast<word_t>(s.size()));
+                bytes.append(s); }
+
+            public: std::string const&str() const {
+                return bytes; }
+        };
+
+        class Reader {
+            private:
+                byte_t const*p;
+                byte_t const*end;
+
+            public: Reader(byte_t const*const data, std::size_t const size) :
+                p{data},
+                end{data + size}
+            { ; }
+
+            public: byte_t u8() {
+                return *take(1); }
+            public: word_t u32() {
+                byte_t const*const q{take(4)};
+                return static_cast<word_t>(q[0]) | static_cast<word_t>(q[1])
+                    << 8 | static_cast<word_t>(q[2]) << 16
+                    | static_cast<word_t>(q[3]) << 24; }
+            public: uint_t u64() {
+                uint_t const low{u32()};
+                return low | static_cast<uint_t>(u32()) << 32; }
+            public: byte_t const*raw(std::size_t const n) {
+                return take(n); }
+            public: std::string string() {
+                word_t const n{u32()};
+                return std::string{reinterpret_cast<char const*>(take(n)), n}; }
+            public: std::size_t remaining() const {
+                return static_cast<std::size_t>(end - p); }
+
+            private: byte_t const*take(std::size_t const n) {
+                if (static_cast<std::size_t>(end - p) < n)
+                    throw std::runtime_error{"object file: truncated"};
+                byte_t const*const q{p};
+                p += n;
+                return q; }
+        };
+
+    public: static void write(
+        std::filesystem::path const&filepath, ComputationState const&cs
+    ) {
+        Sections sections{};
+
+        {
+            Writer w{};
+            w.u64(cs.memory.size());
+            w.u8(static_cast<byte_t>(cs.memoryMode));
+            w.u8(cs.memoryIsDynamic);
+            w.u8(cs.embedProfilerOutput);
+            writeStack(w, cs.debug.stackBoundaries);
+            w.u32(cs.registerSC);
+            sections.emplace_back(Section::Machine, w.str());
+        }
+
+        {
+            std::size_t const last{cs.memory.lastNonZero()};
+            std::size_t const imageSize{!cs.memory.empty()
+                && cs.memory.read(last) != 0 ? last+1 : 0};
+            std::string image(imageSize, '\0');
+            cs.memory.copyOut(0, reinterpret_cast<byte_t *>(image.data()),
+                imageSize);
+            sections.emplace_back(Section::Image, std::move(image));
+        }
+
+        if (cs.memory.hasSemantics())
+            sections.emplace_back(Section::Semantics,
+                semanticsSection(cs.memory.semantics()));
+
+        if (cs.rng.isSeeded())
+            sections.emplace_back(Section::RNG, cs.rng.state());
+
+        std::vector<std::tuple<word_t, bool, std::string>> directives{};
+        for (std::size_t m{0}; m < cs.profiler.size(); ++m)
+            for (auto const&[doStart, msg] : cs.profiler[m])
+                directives.emplace_back(static_cast<word_t>(m), doStart, msg);
+        sections.emplace_back(Section::Profiler, profilerSection(directives));
+
+        sections.emplace_back(Section::SourceMap,
+            sourceMapSection(cs.debug.sourceMap));
+
+        writeFile(filepath, sections);
+    }
+
+    public: static void write(
+        std::filesystem::path const&filepath, Module const&module
+    ) {
+        Sections sections{};
+
+        {
+            Writer w{};
+            w.u8(static_cast<byte_t>(module.memoryMode));
+            w.u8(module.staticProgram);
+            w.u8(module.staticStackCheck);
+            w.u8(module.memoryIsDynamic);
+            w.u8(module.embedProfilerOutput);
+            w.u8(module.haltInstructionWasUsed);
+            w.u8(module.stackInstructionWasUsed);
+            for (std::optional<word_t> const&o : {
+                module.memorySize, module.rngSeed}
+            ) {
+                w.u8(o.has_value());
+                w.u32(o.value_or(0)); }
+            writeStack(w, module.stack);
+            sections.emplace_back(Section::Module, w.str());
+        }
+
+        sections.emplace_back(Section::Image, std::string{
+            module.image.begin(), module.image.end()});
+        if (module.oSemantics.has_value())
+            sections.emplace_back(Section::Semantics,
+                semanticsSection(module.oSemantics.value()));
+        sections.emplace_back(Section::Profiler,
+            profilerSection(module.profiler));
+        sections.emplace_back(Section::SourceMap,
+            sourceMapSection(module.sourceMap));
+
+        {
+            Writer w{};
+            w.u32(static_cast<word_t>(module.exports.size()));
+            for (auto const&[label, address] : module.exports) {
+                w.string(label);
+                w.u32(address); }
+            sections.emplace_back(Section::Exports, w.str());
+        }
+
+        {
+            Writer w{};
+            w.u32(static_cast<word_t>(module.relocations.size()));
+            for (Module::Relocation const&relocation : module.relocations) {
+                w.u32(relocation.address);
+                w.u8(relocation.symbol.has_value());
+                if (relocation.symbol.has_value())
+                    w.string(relocation.symbol.value()); }
+            sections.emplace_back(Section::Relocations, w.str());
+        }
+
+        writeFile(filepath, sections);
+    }
+
+    public: static ComputationState load(
+        std::filesystem::path const&filepath
+    ) {
+        MappedFile const file{filepath};
+        std::map<Section, Reader> sections{readFile(file, filepath)};
+        if (Util::std20::contains(sections, Section::Module))
+            throw std::runtime_error{"object file holds a module, which is "
+                "to be linked: " + filepath.string()};
+
+        Reader &machine{sectionOf(sections, Section::Machine)};
+        uint_t const memorySize{machine.u64()};
+        if (memorySize > std::numeric_limits<word_t>::max())
+            throw std::runtime_error{"object file: memory too large"};
+        MemoryMode const memoryMode{static_cast<MemoryMode>(
+            machine.u8() != 0)};
+        bool const memoryIsDynamic{machine.u8() != 0};
+        bool const embedProfilerOutput{machine.u8() != 0};
+        std::optional<std::tuple<word_t, word_t>> const stack{
+            readStack(machine)};
+        word_t const registerSC{machine.u32()};
+
+        std::optional<SemanticMap> oSemantics{std::nullopt};
+        if (Util::std20::contains(sections, Section::Semantics))
+            oSemantics.emplace(readSemantics(sectionOf(sections, Section::Semantics),
+                memorySize));
+
+        Util::rng_t rng{};
+        if (Util::std20::contains(sections, Section::RNG)) {
+            Reader &state{sectionOf(sections, Section::RNG)};
+            std::size_t const n{state.remaining()};
+            if (!rng.restore(std::string{
+                reinterpret_cast<char const*>(state.raw(n)), n}))
+                throw std::runtime_error{"object file: malformed random "
+                    "number engine state"};
+        }
+
+        std::vector<std::vector<std::tuple<bool, std::string>>> profiler{};
+        for (auto &[m, doStart, msg] : readProfiler(
+            sectionOf(sections, Section::Profiler), memorySize)
+        ) {
+            if (profiler.size() < std::size_t{m}+1)
+                profiler.resize(std::size_t{m}+1);
+            profiler[m].emplace_back(doStart, std::move(msg)); }
+
+        ComputationState cs{static_cast<word_t>(memorySize), memoryIsDynamic,
+            memoryMode, rng, profiler, embedProfilerOutput,
+            std::move(oSemantics)};
+
+        Reader &image{sectionOf(sections, Section::Image)};
+        std::size_t const imageSize{image.remaining()};
+        if (imageSize > memorySize)
+            throw std::runtime_error{"object file: image exceeds memory"};
+        cs.memory.copyIn(0, image.raw(imageSize), imageSize);
+
+        cs.debug.stackBoundaries = stack;
+        cs.registerSC = registerSC;
+        cs.debug.sourceMap = readSourceMap(sectionOf(sections, Section::SourceMap));
+
+        return cs;
+    }
+
+    public: static Module loadModule(std::filesystem::path const&filepath) {
+        MappedFile const file{filepath};
+        std::map<Section, Reader> sections{readFile(file, filepath)};
+        Module module{};
+
+        Reader &header{sectionOf(sections, Section::Module)};
+        module.memoryMode = static_cast<MemoryMode>(header.u8() != 0);
+        module.staticProgram = header.u8() != 0;
+        module.staticStackCheck = header.u8() != 0;
+        module.memoryIsDynamic = header.u8() != 0;
+        module.embedProfilerOutput = header.u8() != 0;
+        module.haltInstructionWasUsed = header.u8() != 0;
+        module.stackInstructionWasUsed = header.u8() != 0;
+        for (std::optional<word_t> *const o : {
+            &module.memorySize, &module.rngSeed}
+        ) {
+            bool const has{header.u8() != 0};
+            word_t const w{header.u32()};
+            if (has)
+                *o = std::make_optional(w); }
+        module.stack = readStack(header);
+
+        Reader &image{sectionOf(sections, Section::Image)};
+        std::size_t const imageSize{image.remaining()};
+        byte_t const*const bytes{image.raw(imageSize)};
+        module.image.assign(bytes, bytes + imageSize);
+
+        if (Util::std20::contains(sections, Section::Semantics)) {
+            module.oSemantics.emplace(readSemantics(
+                sectionOf(sections, Section::Semantics), imageSize));
+            if (module.oSemantics.value().size() != imageSize)
+                throw std::runtime_error{"object file: memory semantics do "
+                    "not match the module"};
+        }
+        module.profiler = readProfiler(sectionOf(sections, Section::Profiler),
+            imageSize);
+        module.sourceMap = readSourceMap(sectionOf(sections, Section::SourceMap));
+
+        Reader &exports{sectionOf(sections, Section::Exports)};
+        for (word_t j{0}, n{exports.u32()}; j < n; ++j) {
+            std::string label{exports.string()};
+            module.exports.emplace_back(std::move(label), exports.u32()); }
+
+        Reader &relocations{sectionOf(sections, Section::Relocations)};
+        for (word_t j{0}, n{relocations.u32()}; j < n; ++j) {
+            Module::Relocation relocation{relocations.u32(), std::nullopt};
+            if (relocations.u8() != 0)
+                relocation.symbol = std::make_optional(relocations.string());
+            if (!module.relocations.empty()
+                && module.relocations.back().address >= relocation.address)
+                throw std::runtime_error{"object file: relocations out of "
+                    "order"};
+            module.relocations.push_back(std::move(relocation)); }
+
+        return module;
+    }
+
+    private: static void writeStack(
+        Writer &w, std::optional<std::tuple<word_t, word_t>> const&stack
+    ) {
+        auto const[begin, end]{stack.value_or(
+            std::make_tuple(word_t{0}, word_t{0}))};
+        w.u8(stack.has_value());
+        w.u32(begin);
+        w.u32(end); }
+
+    private: static std::optional<std::tuple<word_t, word_t>> readStack(
+        Reader &r
+    ) {
+        bool const has{r.u8() != 0};
+        word_t const begin{r.u32()}, end{r.u32()};
+        if (!has)
+            return std::nullopt;
+        return std::make_optional(std::make_tuple(begin, end)); }
+
+    private: static std::string semanticsSection(SemanticMap const&semantics) {
+        Writer w{};
+        w.u64(semantics.size());
+        w.raw(semantics.packedData(),
+            SemanticMap::packedSize(semantics.size()));
+        return w.str(); }
+
+    private: static SemanticMap readSemantics(Reader &r, uint_t const limit) {
+        uint_t const size{r.u64()};
+        if (size > limit)
+            throw std::runtime_error{"object file: memory semantics exceed "
+                "memory"};
+        return SemanticMap{r.raw(SemanticMap::packedSize(
+            static_cast<std::size_t>(size))), static_cast<std::size_t>(size)}; }
+
+    private: static std::string profilerSection(
+        std::vector<std::tuple<word_t, bool, std::string>> const&directives
+    ) {
+        Writer w{};
+        w.u32(static_cast<word_t>(directives.size()));
+        for (auto const&[m, doStart, msg] : directives) {
+            w.u32(m);
+            w.u8(doStart);
+            w.string(msg); }
+        return w.str(); }
+
+    /* a directive following a program's last instruction sits at its
+       end, such that only addresses beyond `limit` are rejected */
+    private: static std::vector<std::tuple<word_t, bool, std::string>>
+    readProfiler(Reader &r, uint_t const limit) {
+        std::vector<std::tuple<word_t, bool, std::string>> directives{};
+        for (word_t j{0}, n{r.u32()}; j < n; ++j) {
+            word_t const m{r.u32()};
+            if (m > limit)
+                throw std::runtime_error{"object file: profiler directive "
+                    "beyond memory"};
+            bool const doStart{r.u8() != 0};
+            directives.emplace_back(m, doStart, r.string()); }
+        return directives; }
+
+    private: static std::string sourceMapSection(SourceMap const&sourceMap) {
+        Writer w{};
+        w.u32(static_cast<word_t>(sourceMap.files.size()));
+        for (std::filesystem::path const&filepath : sourceMap.files)
+            w.string(filepath.string());
+        w.u32(static_cast<word_t>(sourceMap.lines.size()));
+        for (SourceLine const&ln : sourceMap.lines) {
+            w.u32(ln.address);
+            w.u32(ln.count);
+            w.u32(ln.file);
+            w.u32(ln.line);
+            w.u8(ln.instruction); }
+        w.u32(static_cast<word_t>(sourceMap.labels.size()));
+        for (auto const&[m, label] : sourceMap.labels) {
+            w.u32(m);
+            w.string(label); }
+        return w.str(); }
+
+    private: static SourceMap readSourceMap(Reader &r) {
+        SourceMap sourceMap{};
+        for (word_t j{0}, n{r.u32()}; j < n; ++j)
+            sourceMap.files.emplace_back(r.string());
+        for (word_t j{0}, n{r.u32()}; j < n; ++j) {
+            SourceLine ln{};
+            ln.address = r.u32();
+            ln.count = r.u32();
+            ln.file = r.u32();
+            ln.line = r.u32();
+            ln.instruction = r.u8() != 0;
+            if (ln.file >= sourceMap.files.size())
+                throw std::runtime_error{"object file: source line of an "
+                    "unknown file"};
+            sourceMap.lines.push_back(ln); }
+        for (word_t j{0}, n{r.u32()}; j < n; ++j) {
+            word_t const m{r.u32()};
+            sourceMap.labels.emplace_back(m, r.string()); }
+        return sourceMap; }
+
+    private: static void writeFile(
+        std::filesystem::path const&filepath, Sections const&sections
+    ) {
+        std::ofstream out{filepath, std::ios::binary};
+        if (!out)
+            throw std::runtime_error{"could not open object file for "
+                "writing: " + filepath.string()};
+
+        /* sections are aligned to eight bytes */
+        auto const align{[](uint_t const n) { return (n + 7) / 8 * 8; }};
+        Writer header{};
+        header.raw(reinterpret_cast<byte_t const*>("JOYO"), 4);
+        header.u32(version);
+        header.u32(static_cast<word_t>(sections.size()));
+        header.u32(0);
+        uint_t offset{align(16 + 24*sections.size())};
+        for (auto const&[section, contents] : sections) {
+            header.u32(static_cast<word_t>(section));
+            header.u32(0);
+            header.u64(offset);
+            header.u64(contents.size());
+            offset = align(offset + contents.size()); }
+
+        std::string const padding(8, '\0');
+        out << header.str() << padding.substr(0,
+            align(header.str().size()) - header.str().size());
+        for (auto const&[_, contents] : sections)
+            out << contents << padding.substr(0,
+                align(contents.size()) - contents.size());
+        if (!out)
+            throw std::runtime_error{"could not write object file: "
+                + filepath.string()};
+    }
+
+    private: static std::map<Section, Reader> readFile(
+        MappedFile const&file, std::filesystem::path const&filepath
+    ) {
+        Reader header{file.data(), file.size()};
+        if (file.size() < 4 || std::memcmp(header.raw(4), "JOYO", 4) != 0)
+            throw std::runtime_error{"not an object file: "
+                + filepath.string()};
+        if (word_t const v{header.u32()}; v != version)
+            throw std::runtime_error{"object file: unsupported version "
+                + std::to_string(v)};
+
+        std::map<Section, Reader> sections{};
+        word_t const nSections{header.u32()};
+        header.u32();
+        for (word_t j{0}; j < nSections; ++j) {
+            Section const section{static_cast<Section>(header.u32())};
+            header.u32();
+            uint_t const offset{header.u64()}, size{header.u64()};
+            if (offset > file.size() || size > file.size() - offset)
+                throw std::runtime_error{"object file: section out of "
+                    "bounds"};
+            sections.emplace(section, Reader{file.data() + offset,
+                static_cast<std::size_t>(size)});
+        }
+        return sections; }
+
+    private: static Reader &sectionOf(
+        std::map<Section, Reader> &sections, Section const section
+    ) {
+        auto const it{sections.find(section)};
+        if (it == sections.end())
+            throw std::runtime_error{"object file: missing section "
+                + std::to_string(static_cast<word_t>(section))};
+        return it->second; }
+};
+
+#endif
@@ -0,0 +1,364 @@
+#ifndef JOY_ASSEMBLER__OPTIMIZER_CPP
+#define JOY_ASSEMBLER__OPTIMIZER_CPP
+
+#include "Includes.hpp"
+
+/* A peephole optimizer over an assembled program. As every instruction
+   keeps its address, code is never removed; instead, instructions are
+   rewritten in place:
+     - jumps and calls whose target is a `JMP` or a `NOP` are threaded
+       to where control ends up;
+     - straight-line runs of instructions which only compute `A` (`MOV`,
+       `INC`, `DEC`, `SHL`, `SHR`, `NOT`, `NEG`, `NOP`) are folded, e.g.
+       `MOV k; INC j` into `MOV k+j` and `SHL a; SHL b` into `SHL a+b`,
+       and the remainder of the run is jumped over;
+     - a store is replaced by a `NOP` when the same word is stored to
+       again before anything could read it.
+   Only static programs (see `pragma_static-program`), which cannot modify
+   their own code, are optimized, and none using the profiler, whose
+   counts are to stay exact. Folding requires knowing every instruction
+   control can enter at, which are taken to be the arguments of jumps and
+   calls and return addresses; programs using `LPC` or `SPC` are not
+   folded, nor are programs using `RET` unless `StackAnalysis` bounded
+   their stack, which proves each `RET` to return behind its `CAL`. */
+class Optimizer {
+    private:
+        /* micro-instructions saved whenever the instruction at an address
+           is executed, plus `takenSaving` if control continues at
+           `target` */
+        struct Site { uint_t saving, takenSaving; word_t target; };
+
+        std::map<word_t, Site> sites;
+        uint_t nThreaded, nFolded, nDeadStores;
+        uint_t staticSaving, dynamicSaving;
+
+    public: Optimizer() :
+        sites{},
+        nThreaded{0}, nFolded{0}, nDeadStores{0},
+        staticSaving{0}, dynamicSaving{0}
+    { ; }
+
+    public: bool optimize(ComputationState &cs) {
+        if (!cs.memory.hasSemantics()) {
+            report("not optimizing a program which is not static");
+            return false; }
+        for (auto const&directives : cs.profiler)
+            if (!directives.empty()) {
+                report("not optimizing a program using the profiler");
+                return false; }
+
+        SemanticMap const&semantics{cs.memory.semantics()};
+        std::map<word_t, Instruction> code{};
+        for (std::size_t m{0}; m + 5 <= semantics.size(); ++m)
+            if (semantics[m] == MemorySemantic::InstructionHead)
+                code.emplace(static_cast<word_t>(m), load(cs,
+                    static_cast<word_t>(m)));
+        thread(cs, code);
+        fold(cs, code);
+        eliminateDeadStores(cs, code);
+
+        report(std::to_string(nThreaded) + " jumps threaded, "
+            + std::to_string(nFolded) + " runs folded, "
+            + std::to_string(nDeadStores) + " dead stores removed; "
+            + std::to_string(staticSaving) + " micro-instructions saved "
+            "statically");
+        return true; }
+
+    /* Runs a program to its end, one instruction at a time, such that
+       the micro-instructions saved by optimizing it are accounted for. */
+    public: StopReason run(ComputationState &cs) {
+        StopReason reason{StopReason::BudgetExhausted};
+        do {
+            word_t const pc{cs.registerPC};
+            reason = cs.run(1);
+            if (reason == StopReason::Fault)
+                break;
+            if (auto const it{sites.find(pc)}; it != sites.end()) {
+                dynamicSaving += it->second.saving;
+                if (cs.registerPC == it->second.target)
+                    dynamicSaving += it->second.takenSaving; }
+        } while (reason == StopReason::BudgetExhausted
+            || reason == StopReason::ProfilerBoundary);
+
+        report(std::to_string(dynamicSaving) + " micro-instructions saved "
+            "dynamically (" + std::to_string(cs.statistics.nMicroInstructions)
+            + " executed instead of " + std::to_string(
+                cs.statistics.nMicroInstructions + dynamicSaving) + ")");
+        return reason; }
+
+    /* Redirects a jump or call past any `JMP` and `NOP` it would reach.
+       Threading comes first, such that every instruction passed over is
+       an original one. */
+    private: void thread(
+        ComputationState &cs, std::map<word_t, Instruction> &code
+    ) {
+        for (auto &[m, instruction] : code) {
+            if (instruction.name != InstructionName::CAL
+                && !InstructionNameRepresentationHandler
+                    ::doesPointAtInstruction(instruction.name))
+                continue;
+
+            word_t target{instruction.argument};
+            uint_t saving{0};
+            std::set<word_t> visited{};
+            while (visited.insert(target).second) {
+                auto const it{code.find(target)};
+                if (it == code.end())
+                    break;
+                Instruction const&hop{it->second};
+                if (hop.name == InstructionName::JMP)
+                    target = hop.argument;
+                else if (hop.name == InstructionName::NOP
+                    && Util::std20::contains(code, target+5))
+                    target += 5;
+                else
+                    break;
+                saving += cost(hop);
+            }
+            if (saving == 0)
+                continue;
+
+            instruction.argument = target;
+            cs.storeInstruction(m, instruction);
+            sites[m].takenSaving = saving;
+            sites[m].target = target;
+            staticSaving += saving;
+            ++nThreaded;
+        }
+    }
+
+    private: void fold(
+        ComputationState &cs, std::map<word_t, Instruction> &code
+    ) {
+        for (auto const&[_, instruction] : code)
+            if (instruction.name == InstructionName::LPC
+                || instruction.name == InstructionName::SPC)
+                return;
+        for (auto const&[_, instruction] : code)
+            if (instruction.name == InstructionName::RET) {
+                cs.verify();
+                if (!cs.oStackDepth.has_value())
+                    return;
+                break; }
+        std::set<word_t> const entries{entryPoints(code)};
+
+        auto it{code.begin()};
+        while (it != code.end()) {
+            if (!computesA(it->second)) {
+                ++it;
+                continue; }
+
+            word_t const begin{it->first};
+            std::vector<Instruction> run{it->second};
+            for (++it; it != code.end() && computesA(it->second)
+                && it->first == begin + 5*run.size()
+                && !Util::std20::contains(entries, it->first); ++it)
+                run.push_back(it->second);
+            word_t const end{static_cast<word_t>(begin + 5*run.size())};
+
+            std::vector<Instruction> folded{reduce(run)};
+            uint_t before{0}, after{0};
+            for (Instruction const&instruction : run)
+                before += cost(instruction);
+            for (Instruction const&instruction : folded)
+                after += cost(instruction);
+
+            Instruction const nop{InstructionName::NOP, 0};
+            Instruction const jmp{InstructionName::JMP, end};
+            bool const jump{Util::std20::contains(code, end)
+                && cost(jmp) < (run.size() - folded.size()) * cost(nop)};
+            after += jump ? cost(jmp)
+                : (run.size() - folded.size()) * cost(nop);
+            if (after >= before)
+                continue;
+
+            if (jump)
+                folded.push_back(jmp);
+            while (folded.size() < run.size())
+                folded.push_back(nop);
+            for (std::size_t j{0}; j < run.size(); ++j) {
+                word_t const m{static_cast<word_t>(begin + 5*j)};
+                code[m] = folded[j];
+                cs.storeInstruction(m, folded[j]); }
+            sites[begin].saving += before - after;
+            staticSaving += before - after;
+            ++nFolded;
+        }
+    }
+
+    private: void eliminateDeadStores(
+        ComputationState &cs, std::map<word_t, Instruction> &code
+    ) {
+        SemanticMap const&semantics{cs.memory.semantics()};
+        auto const isStore{[](Instruction const&instruction) {
+            return instruction.name == InstructionName::STA
+                || instruction.name == InstructionName::STB; }};
+        auto const overlap{[](word_t const x, word_t const y) {
+            return (x > y ? x - y : y - x) < 4; }};
+
+        for (auto it{code.begin()}; it != code.end(); ++it) {
+            auto &[m, instruction] = *it;
+            if (!isStore(instruction))
+                continue;
+            word_t const x{instruction.argument};
+
+            bool dead{false};
+            word_t next{m + 5};
+            for (auto jt{std::next(it)}; jt != code.end()
+                && jt->first == next; ++jt, next += 5
+            ) {
+                Instruction const&later{jt->second};
+                bool const accessesMemory{InstructionNameRepresentationHandler
+                    ::doesPointAtData(later.name)};
+                if (isStore(later) && later.argument == x) {
+                    dead = true;
+                    break; }
+                if (accessesMemory && !overlap(later.argument, x))
+                    continue;
+                if (accessesMemory || !local(later))
+                    break;
+            }
+            if (!dead || x >= semantics.size()
+                || semantics[x] != MemorySemantic::DataHead)
+                continue;
+
+            Instruction const nop{InstructionName::NOP, 0};
+            sites[m].saving += cost(instruction) - cost(nop);
+            staticSaving += cost(instruction) - cost(nop);
+            instruction = nop;
+            cs.storeInstruction(m, nop);
+            ++nDeadStores;
+        }
+    }
+
+    /* where control can enter other than by falling through */
+    private: static std::set<word_t> entryPoints(
+        std::map<word_t, Instruction> const&code
+    ) {
+        std::set<word_t> entries{0};
+        for (auto const&[m, instruction] : code) {
+            if (instruction.name == InstructionName::CAL)
+                entries.insert(m + 5);
+            if (instruction.name == InstructionName::CAL
+                || InstructionNameRepresentationHandler
+                    ::doesPointAtInstruction(instruction.name))
+                entries.insert(instruction.argument); }
+        return entries; }
+
+    /* Shortens a run of instructions computing `A`: everything before the
+       last `MOV` is overwritten by it and everything following it computes
+       a constant; otherwise, neighbouring instructions are combined. */
+    private: static std::vector<Instruction> reduce(
+        std::vector<Instruction> const&run
+    ) {
+        std::vector<Instruction> reduced{};
+        for (Instruction const&instruction : run) {
+            InstructionName const name{instruction.name};
+            word_t const argument{instruction.argument};
+            Instruction *const last{reduced.empty() ? nullptr
+                : &reduced.back()};
+
+            if (name == InstructionName::NOP)
+                continue;
+            if (name == InstructionName::MOV) {
+                reduced.assign(1, instruction);
+                continue; }
+            if (last != nullptr && last->name == InstructionName::MOV) {
+                last->argument = apply(instruction, last->argument);
+                continue; }
+
+            if (name == InstructionName::INC || name == InstructionName::DEC) {
+                word_t const delta{name == InstructionName::INC ? argument
+                    : 0u - argument};
+                if (last == nullptr || (last->name != InstructionName::INC
+                    && last->name != InstructionName::DEC)
+                ) {
+                    reduced.push_back(instruction);
+                    continue; }
+                word_t const sum{apply(*last, delta)};
+                reduced.pop_back();
+                if (sum != 0)
+                    reduced.push_back(sum < 0x80000000
+                        ? Instruction{InstructionName::INC, sum}
+                        : Instruction{InstructionName::DEC, 0u - sum});
+                continue; }
+
+            if ((name == InstructionName::SHL || name == InstructionName::SHR)
+                && last != nullptr && last->name == name
+            ) {
+                last->argument = static_cast<word_t>(std::min(uint_t{32},
+                    uint_t{last->argument} + argument));
+                continue; }
+
+            if ((name == InstructionName::NOT || name == InstructionName::NEG)
+                && last != nullptr && last->name == name
+            ) {
+                reduced.pop_back();
+                continue; }
+
+            reduced.push_back(instruction);
+        }
+        return reduced; }
+
+    /* `A` after executing an instruction computing it */
+    private: static word_t apply(
+        Instruction const&instruction, word_t const a
+    ) {
+        word_t const arg{instruction.argument};
+        InstructionName const name{instruction.name};
+        if (name == InstructionName::MOV)
+            return arg;
+        if (name == InstructionName::NOT)
+            return ~a;
+        if (name == InstructionName::SHL)
+            return arg < 32 ? a << arg : 0;
+        if (name == InstructionName::SHR)
+            return arg < 32 ? a >> arg : 0;
+        if (name == InstructionName::INC)
+            return a + arg;
+        if (name == InstructionName::DEC)
+            return a - arg;
+        if (name == InstructionName::NEG)
+            return 0u - a;
+        return a; }
+
+    private: static bool computesA(Instruction const&instruction) {
+        return Util::contains(std::array{
+            InstructionName::NOP, InstructionName::MOV,
+            InstructionName::NOT, InstructionName::SHL,
+            InstructionName::SHR, InstructionName::INC,
+            InstructionName::DEC, InstructionName::NEG,
+        }, instruction.name); }
+
+    /* whether an instruction neither transfers control, touches memory
+       besides through a fixed address nor can fail */
+    private: static bool local(Instruction const&instruction) {
+        return computesA(instruction) || Util::contains(std::array{
+            InstructionName::SWP, InstructionName::ADD,
+            InstructionName::SUB, InstructionName::AND,
+            InstructionName::OR, InstructionName::XOR,
+            InstructionName::PTU, InstructionName::PTS,
+            InstructionName::PTB, InstructionName::PTC,
+            InstructionName::RND, InstructionName::LSC,
+        }, instruction.name); }
+
+    private: static uint_t cost(Instruction const&instruction) {
+        return InstructionNameRepresentationHandler::microInstructions(
+            instruction.name); }
+
+    private: static word_t loadWord(ComputationState &cs, word_t const m) {
+        word_t w{0};
+        for (word_t k{0}; k < 4; ++k)
+            w |= static_cast<word_t>(cs.memory.read(m+k))
+                << 8*(cs.memoryMode == MemoryMode::LittleEndian ? k : 3-k);
+        return w; }
+
+    private: static Instruction load(ComputationState &cs, word_t const m) {
+        return Instruction{InstructionNameRepresentationHandler::fromByteCode(
+            cs.memory.read(m)), loadWord(cs, m+1)}; }
+
+    private: static void report(std::string const&msg) {
+        std::clog << "optimizer: " << msg << std::endl; }
+};
+
+#endif
@@ -5,21 +5,43 @@
 
 class Parser {
     private:
-        using parsingInstruction = std::tuple<
-            InstructionName, std::optional<std::string>>;
-        using parsingData = word_t;
+        using fileId_t = uint32_t;
+        using lineNumber_t = uint32_t;
+        using symbolId_t = uint32_t;
+
+        struct SourceLocation { fileId_t file; lineNumber_t line; };
+        /* the argument is kept unresolved, as an interned string */
+        struct ParsedInstruction {
+            InstructionName name;
+            std::optional<symbolId_t> argument;
+        };
+        /* `count` copies of a data word */
+        struct ParsedFill { word_t value; word_t count; };
+        /* `count` data words stored consecutively in `blobs` */
+        struct ParsedBlob { std::size_t offset; word_t count; };
+        struct ParsedPiece {
+            SourceLocation location;
+            std::variant<ParsedInstruction, ParsedFill, ParsedBlob> piece;
+        };
 
     private:
+        SourceCache sourceCache;
+        /* files lexed ahead of being parsed */
+        std::map<std::filesystem::path, LexedFile> lexedFiles;
         std::set<std::filesystem::path> parsedFilepaths;
-        std::vector<std::tuple<std::filesystem::path, uint_t,
-            std::variant<parsingInstruction, parsingData>>> parsing;
-        std::map<std::string, std::tuple<uint_t, std::string>>
+        std::vector<std::filesystem::path> files;
+        std::vector<std::string> symbols;
+        std::unordered_map<std::string, symbolId_t> symbolIds;
+        std::vector<ParsedPiece> parsing;
+        std::vector<word_t> blobs;
+        std::unordered_map<std::string, std::tuple<uint_t, std::string>>
             definitions;
         bool stackInstructionWasUsed;
         std::optional<word_t> stackBeginning;
         std::optional<word_t> stackEnd;
 
         word_t memorySize;
+        std::optional<word_t> pragmaMemorySize;
         bool memoryIsDynamic;
 
         MemoryMode pragmaMemoryMode;
@@ -30,19 +52,26 @@ class Parser {
         std::vector<std::vector<std::tuple<bool, std::string>>> profiler;
         bool embedProfilerOutput;
 
-        std::optional<std::vector<MemorySemantic>> oMemorySemantics;
+        std::optional<SemanticMap> oMemorySemantics;
 
         Util::rng_t rng;
 
     public: Parser() :
+        sourceCache{},
+        lexedFiles{},
         parsedFilepaths{},
+        files{},
+        symbols{},
+        symbolIds{},
         parsing{},
+        blobs{},
         definitions{},
         stackInstructionWasUsed{false},
         stackBeginning{std::nullopt},
         stackEnd{std::nullopt},
 
         memorySize{/*TODO possibly odd gcc diagnostic when writing `-1`*/},
+        pragmaMemorySize{std::nullopt},
         memoryIsDynamic{false},
 
         pragmaMemoryMode{MemoryMode::LittleEndian},
@@ -66,6 +95,11 @@ class Parser {
                   << ": " << msg << std::endl;
         return false; }
 
+    public: bool error(
+        SourceLocation const&location, std::string const&msg
+    ) const {
+        return error(files[location.file], location.line, msg); }
+
     public: bool error(std::string const&msg) const {
         std::cerr << msg << std::endl;
         return false; }
@@ -76,6 +110,34 @@ class Parser {
         else if (arg == "step") {
             cs.debug.doVisualizeSteps = true;
             cs.debug.doWaitForUser = true; }
+        else if (arg == "switch")
+            cs.debug.engine = ExecutionEngine::Switch;
+        else if (arg == "threaded")
+            cs.debug.engine = ExecutionEngine::Threaded;
+        else if (arg == "jit")
+            cs.debug.engine = ExecutionEngine::Native;
+        else if (arg == "guarded-memory") {
+            if (!cs.guardMemory())
+                return error("guarded memory is not available for this "
+                    "program or platform"); }
+        else if (arg == "flush-on-newline")
+            cs.setOutput(std::make_unique<MachineIO::StreamSink>(
+                std::cout, MachineIO::FlushPolicy::Newline));
+        else if (arg == "flush-on-input")
+            cs.setOutput(std::make_unique<MachineIO::StreamSink>(
+                std::cout, MachineIO::FlushPolicy::Input));
+        else if (arg == "flush-on-halt")
+            cs.setOutput(std::make_unique<MachineIO::StreamSink>(
+                std::cout, MachineIO::FlushPolicy::Halt));
+        else if (arg == "input-tape")
+            cs.setInput(std::make_unique<MachineIO::TapeSource>(std::cin));
+        else if (arg.rfind("input-tape=", 0) == 0) {
+            std::string const filepath{arg.substr(11)};
+            std::unique_ptr<MachineIO::TapeSource> tape{
+                MachineIO::TapeSource::open(filepath)};
+            if (!tape)
+                return error("could not open input tape: " + filepath);
+            cs.setInput(std::move(tape)); }
         else
             return error("unknown commandline argument: " + arg);
         return true; }
@@ -83,6 +145,7 @@ class Parser {
     public: std::optional<ComputationState> parse(
         std::filesystem::path const&filepath
     ) {
+        lexIncludeTree(filepath);
         word_t memPtr{0};
         if (!parseFiles(filepath, memPtr))
             return std::nullopt;
@@ -99,8 +162,58 @@ class Parser {
         if (!parseAssemble(oCS.value()))
             return std::nullopt;
 
+        std::optional<std::string> const oWarning{
+            oCS.value().stackWarning()};
+        if (oWarning.has_value())
+            std::cerr << "parsing: warning: " << oWarning.value() << std::endl;
+
         return oCS; }
 
+    /* Assembles a file into a module (see `Linker`) instead of a
+       program: arguments referring to labels are recorded as relocations,
+       labels no file defines as imports. Static analysis, the halt
+       instruction and the stack are only checked once linked. */
+    public: std::optional<Module> compile(
+        std::filesystem::path const&filepath
+    ) {
+        lexIncludeTree(filepath);
+        word_t memPtr{0};
+        if (!parseFiles(filepath, memPtr))
+            return std::nullopt;
+
+        if (!pragmas(filepath))
+            return std::nullopt;
+
+        Module module{};
+        module.memoryMode = pragmaMemoryMode;
+        module.staticProgram = pragmaStaticProgram;
+        module.staticStackCheck = pragmaStaticStackCheck;
+        module.memoryIsDynamic = memoryIsDynamic;
+        module.embedProfilerOutput = embedProfilerOutput;
+        module.memorySize = pragmaMemorySize;
+        module.rngSeed = pragmaRNGSeed;
+        module.oSemantics = constructMemorySemantics();
+
+        ComputationState cs{memPtr, false, pragmaMemoryMode, rng,
+            profiler, embedProfilerOutput, std::nullopt};
+        if (!parseAssemble(cs, &module))
+            return std::nullopt;
+
+        module.image.resize(cs.memory.size());
+        cs.memory.copyOut(0, module.image.data(), module.image.size());
+        for (auto const&[name, definition] : definitions)
+            if (name.front() == '@')
+                module.exports.emplace_back(name.substr(1), static_cast<word_t>(
+                    std::stoul(std::get<1>(definition))));
+        for (std::size_t m{0}; m < profiler.size(); ++m)
+            for (auto const&[doStart, msg] : profiler[m])
+                module.profiler.emplace_back(static_cast<word_t>(m), doStart,
+                    msg);
+        module.stack = cs.debug.stackBoundaries;
+        module.sourceMap = std::move(cs.debug.sourceMap);
+
+        return std::make_optional(std::move(module)); }
+
     private: bool parseFiles(
         std::filesystem::path const&filepath, word_t &memPtr
     ) {
@@ -116,30 +229,65 @@ class Parser {
                 + filepath.u8string());
         parsedFilepaths.insert(filepath);
 
-        std::ifstream f{filepath};
-        if (!f.is_open())
+        std::optional<LexedFile> oLexed{std::nullopt};
+        if (auto const it{lexedFiles.find(filepath)}; it != lexedFiles.end()
+        ) {
+            oLexed = std::make_optional(std::move(it->second));
+            lexedFiles.erase(it); }
+        else
+            oLexed = lexFile(filepath);
+        if (!oLexed.has_value())
             return error("unable to read file: " + filepath.u8string());
 
-        std::string const regexIdentifier{"[[:alpha:]_][[:alnum:]_$-]*"};
-        std::string const regexValue{"['@[:alnum:]+-][^,]*"};
-        std::string const regexString{"\"([^\"]|\\\")*?\""};
-
-        /***/
+        fileId_t const file{static_cast<fileId_t>(files.size())};
+        files.push_back(filepath);
 
         uint_t lineNumber{1};
-        std::string ln{};
 
+        auto const location{[&]() {
+            return SourceLocation{file, static_cast<lineNumber_t>(lineNumber)};
+        }};
+
+        /* consecutive words of one line share a blob */
         auto const pushData{[&](uint32_t const data) {
-            parsing.push_back(std::make_tuple(filepath, lineNumber,
-                parsingData{data}));
+            if (!parsing.empty()) {
+                ParsedPiece &last{parsing.back()};
+                ParsedBlob *const blob{std::get_if<ParsedBlob>(&last.piece)};
+                if (blob != nullptr && last.location.file == file
+                    && last.location.line == lineNumber
+                    && blob->offset + blob->count == blobs.size()
+                ) {
+                    blobs.push_back(data);
+                    ++blob->count;
+                    memPtr += 4;
+                    return; }
+            }
+            parsing.push_back(ParsedPiece{location(),
+                ParsedBlob{blobs.size(), 1}});
+            blobs.push_back(data);
             memPtr += 4;
         }};
 
+        auto const pushFill{[&](word_t const value, word_t const count) {
+            if (count == 0)
+                return;
+            parsing.push_back(ParsedPiece{location(),
+                ParsedFill{value, count}});
+            memPtr += 4*count;
+        }};
+
         auto const pushInstruction{[&](
             InstructionName const name, std::optional<std::string> const&oArg
         ) {
-            parsing.push_back(std::make_tuple(filepath, lineNumber,
-                parsingInstruction{std::make_tuple(name, oArg)}));
+            std::optional<symbolId_t> oSymbol{std::nullopt};
+            if (oArg.has_value()) {
+                auto const[it, inserted]{symbolIds.try_emplace(oArg.value(),
+                    static_cast<symbolId_t>(symbols.size()))};
+                if (inserted)
+                    symbols.push_back(oArg.value());
+                oSymbol = std::make_optional(it->second); }
+            parsing.push_back(ParsedPiece{location(),
+                ParsedInstruction{name, oSymbol}});
             memPtr += 5;
         }};
 
@@ -147,251 +295,399 @@ class Parser {
             if (Util::std20::contains(definitions, k))
                 return error(filepath, lineNumber,
                     "duplicate definition: " + k);
-            definitions[k] = std::make_tuple(lineNumber, v);
-            pragmas(filepath);
+            /* pragmas are resolved once all files are parsed, yet data
+               drawn while parsing is to already use the seed, which is
+               reapplied after every definition, labels included */
+            if (k == "pragma_rng-seed")
+                if (std::optional<word_t> const oSeed{
+                    Util::stringToOptionalUInt32(v)}; oSeed.has_value())
+                    pragmaRNGSeed = oSeed;
+            if (pragmaRNGSeed.has_value())
+                rng.seed(pragmaRNGSeed.value());
+            definitions.emplace(std::move(k),
+                std::make_tuple(lineNumber, std::move(v)));
 
             return true;
         }};
 
-        std::vector<std::tuple<
-            std::string, std::function<bool(std::smatch const&)>
-        >> const onMatch{
+        auto const parseInclude{[&](std::string const&includeFilepathString) {
+            std::filesystem::path const includeFilepath{
+                filepath.parent_path() / includeFilepathString};
 
-            { "^(" + regexIdentifier + ") ?:= ?(" + regexValue + ")$"
-            , [&](std::smatch const&smatch) {
-                return define(std::string{smatch[1]}, std::string{smatch[2]});
-            }},
+            log("including with memPtr = " + std::to_string(memPtr));
+            if (!parseFiles(includeFilepath, memPtr))
+                return error(filepath, lineNumber, "could not include "
+                    "file: " + includeFilepath.u8string());
+            log("included with memPtr = " + std::to_string(memPtr));
+            return true;
+        }};
 
-            { "^(" + regexIdentifier + "):$"
-            , [&](std::smatch const&smatch) {
-                std::string label{smatch[1]};
-                if (!define("@" + label, std::to_string(memPtr)))
+        auto const parseProfiler{[&](
+            bool const start, std::string profilerMessage
+        ) {
+            profilerMessage = "file " + filepath.u8string() + ", ln "
+                + std::to_string(lineNumber)
+                + std::string{profilerMessage == "" ? "" : ": "}
+                + profilerMessage;
+
+            if (profiler.size() < memPtr+1)
+                profiler.resize(memPtr+1);
+            profiler[memPtr].push_back(std::make_tuple(start,
+                profilerMessage));
+
+            return true;
+        }};
+
+        auto const parseLine{[&](LexedFile::Line const&line) {
+            using L = LexedFile;
+            if (auto const*const def{std::get_if<L::Definition>(&line)})
+                return define(def->name, def->value);
+
+            if (auto const*const label{std::get_if<L::Label>(&line)}) {
+                if (!define("@" + label->name, std::to_string(memPtr)))
                     return false;
-                if (label == "stack" && !stackBeginning.has_value())
+                if (label->name == "stack" && !stackBeginning.has_value())
                     stackBeginning = std::make_optional(memPtr);
-                return true;
-            }},
+                return true; }
+
+            if (auto const*const words{std::get_if<L::Words>(&line)}) {
+                for (word_t const word : words->words)
+                    pushData(word);
+                return true; }
+            if (auto const*const fill{std::get_if<L::Fill>(&line)}) {
+                pushFill(fill->value, fill->count);
+                return true; }
+            if (auto const*const unif{std::get_if<L::Unif>(&line)}) {
+                for (word_t const&rnd : rng.unif(unif->count, unif->range))
+                    pushData(rnd);
+                return true; }
+            if (auto const*const perm{std::get_if<L::Perm>(&line)}) {
+                for (word_t r : rng.perm(perm->count))
+                    pushData(r);
+                return true; }
+
+            if (auto const*const include{std::get_if<L::Include>(&line)})
+                return parseInclude(include->filepath);
+
+            if (auto const*const prof{std::get_if<L::Profiler>(&line)})
+                return parseProfiler(prof->start, prof->message);
+
+            if (auto const*const instr{std::get_if<L::Instruction>(&line)}) {
+                pushInstruction(instr->name, instr->argument);
+                return true; }
+
+            std::optional<std::string> const&oMessage{
+                std::get<L::Error>(line).message};
+            if (oMessage.has_value())
+                error(filepath, lineNumber, oMessage.value());
+            return false;
+        }};
+
+        for (auto const&[ln, line] : oLexed.value().lines) {
+            lineNumber = ln;
+            if (!parseLine(line))
+                return error(filepath, lineNumber, "incomprehensible"); }
+        memorySize = memPtr;
+
+        return true;
+    }
+
+    /* Lexes every file reachable from `filepath` through includes, on as
+       many threads as there are cores, such that assembling the files in
+       place (see `parseFiles`) is left as a cheap sequential pass. Files
+       which cannot be read are not lexed; `parseFiles` reports them. */
+    private: void lexIncludeTree(std::filesystem::path const&filepath) {
+        std::mutex mutex{};
+        std::condition_variable changed{};
+        std::vector<std::filesystem::path> pending{
+            filepath.lexically_normal()};
+        std::set<std::filesystem::path> discovered{pending.front()};
+        uint_t busy{0};
+
+        auto const work{[&]() {
+            std::unique_lock<std::mutex> lock{mutex};
+            while (true) {
+                changed.wait(lock, [&]() {
+                    return !pending.empty() || busy == 0; });
+                if (pending.empty())
+                    return;
+                std::filesystem::path const path{std::move(pending.back())};
+                pending.pop_back();
+                ++busy;
+                lock.unlock();
+
+                std::optional<LexedFile> oLexed{std::nullopt};
+                try { oLexed = lexFile(path); }
+                catch (std::exception const&) { ; }
+
+                lock.lock();
+                --busy;
+                if (oLexed.has_value()) {
+                    for (auto const&[_, line] : oLexed.value().lines)
+                        if (auto const*const include{
+                            std::get_if<LexedFile::Include>(&line)}
+                        ) {
+                            std::filesystem::path included{(path.parent_path()
+                                / include->filepath).lexically_normal()};
+                            if (discovered.insert(included).second)
+                                pending.push_back(std::move(included)); }
+                    lexedFiles.emplace(path, std::move(oLexed.value())); }
+                changed.notify_all();
+            }
+        }};
 
-            { "^data ?(.+)$"
-            , [&](std::smatch const&smatch) {
-                log("parsing `data` ...");
-                std::string commaSeparated{std::string{smatch[1]} + ","};
-                for (uint_t elemNr{1}; commaSeparated != ""; ++elemNr) {
-                    auto dataError = [&](
-                        std::string const&msg, std::string const&detail
-                    ) {
-                        return error(filepath, lineNumber, msg
-                            + " (element number " + std::to_string(elemNr)
-                            + "): " + detail); };
-
-                    std::smatch smatch{};
-                    if (std::regex_match(commaSeparated, smatch, std::regex{
-                        "^(" + ("(\\[(" + regexValue + ")\\])? ?(" + regexValue
-                        + "|" + "runif " + regexValue + "|" + "rperm" + ")?")
-                        + "|" + regexString + ") ?, ?(.*)$"})
-                    ) {
-                        std::string unparsedElement{smatch[1]};
-                        std::string unparsedSize{smatch[3]};
-                        std::string unparsedValue{smatch[4]};
-                        commaSeparated = std::string{smatch[6]};
-
-                        if (unparsedElement == "")
-                            return dataError("invalid data element", "empty");
-
-                        if (unparsedElement.front() == '\"') {
-                            log("parsing string: " + unparsedElement);
-                            std::optional<std::vector<UTF8::rune_t>> const
-                                oRunes{Util::parseString(unparsedElement)};
-                            if (!oRunes.has_value())
-                                return dataError("invalid data string element",
-                                    unparsedElement);
-                            for (UTF8::rune_t rune : oRunes.value())
-                                pushData(static_cast<word_t>(rune));
-                            continue; }
-
-                        log("parsing non-string: " + unparsedElement);
-
-                        if (unparsedSize == "")
-                            unparsedSize = std::string{"1"};
-                        std::optional<word_t> const oSize{
-                            Util::stringToOptionalUInt32(unparsedSize)};
-                        if (!oSize.has_value())
-                            return dataError("invalid data uint element size",
-                                unparsedSize);
-                        log("    ~> size: " + std::to_string(oSize.value()));
-
-                        {
-                            std::smatch smatch{};
-                            if (std::regex_match(unparsedValue, smatch,
-                                std::regex{"^runif (" + regexValue + ")$"})
-                            ) {
-                                unparsedValue = std::string{smatch[1]};
-                                std::optional<word_t> const oValue{
-                                    Util::stringToOptionalUInt32(
-                                        unparsedValue)};
-                                if (!oValue.has_value())
-                                    return dataError("invalid data unif range "
-                                        "value", unparsedValue);
-
-                                for (word_t const&rnd : rng.unif(
-                                    oSize.value(), oValue.value())
-                                )
-                                    pushData(rnd);
-                                continue;
-                            }
-                            if (std::regex_match(unparsedValue, smatch,
-                                std::regex{"^rperm$"})
-                            ) {
-                                for (word_t r : rng.perm(oSize.value()))
-                                    pushData(r);
-                                continue;
-                            }
-                        }
-
-                        log("parsing uint: " + unparsedElement);
-
-                        if (unparsedValue == "")
-                            unparsedValue = std::string{"0"};
-                        std::optional<word_t> const oValue{
-                            Util::stringToOptionalUInt32(unparsedValue)};
-                        if (!oValue.has_value())
-                            return dataError("invalid data uint element value",
-                                unparsedValue);
-                        log("    ~> value: " + std::to_string(oValue.value()));
-
-                        for (word_t j = 0; j < oSize.value(); ++j)
-                            pushData(oValue.value());
-                        continue;
-                    }
+        std::vector<std::thread> workers{};
+        for (unsigned j{1}; j < std::thread::hardware_concurrency(); ++j)
+            workers.emplace_back(work);
+        work();
+        for (std::thread &worker : workers)
+            worker.join();
+    }
 
+    /* an unchanged file is not lexed again (see `SourceCache`) */
+    private: std::optional<LexedFile> lexFile(
+        std::filesystem::path const&filepath
+    ) const {
+        std::error_code ec{};
+        if (!std::filesystem::is_regular_file(filepath, ec))
+            return std::nullopt;
+        std::ifstream f{filepath, std::ios::binary};
+        if (!f.is_open())
+            return std::nullopt;
+        std::string const contents{std::istreambuf_iterator<char>{f},
+            std::istreambuf_iterator<char>{}};
+
+        std::optional<LexedFile> oLexed{sourceCache.load(contents)};
+        if (oLexed.has_value()) {
+            log("reusing cached lexing of " + filepath.u8string());
+            return oLexed; }
+        oLexed = std::make_optional(lex(contents));
+        sourceCache.store(contents, oLexed.value());
+        return oLexed; }
+
+    /* Recognizes each line of a file (see `Syntax`), independently of where
+       it is placed and of what was parsed before it. */
+    private: LexedFile lex(std::string_view const contents) const {
+        LexedFile lexed{};
+        uint32_t lineNumber{1};
+
+        auto const push{[&](LexedFile::Line line) {
+            lexed.lines.emplace_back(lineNumber, std::move(line)); }};
+        auto const fail{[&](std::optional<std::string> const&oMessage) {
+            push(LexedFile::Error{oMessage});
+            return false; }};
+
+        /* consecutive words of one line are kept together */
+        auto const pushData{[&](word_t const data) {
+            if (!lexed.lines.empty()
+                && std::get<0>(lexed.lines.back()) == lineNumber
+            )
+                if (auto *const words{std::get_if<LexedFile::Words>(
+                    &std::get<1>(lexed.lines.back()))}
+                ) {
+                    words->words.push_back(data);
+                    return; }
+            push(LexedFile::Words{{data}});
+        }};
+
+        auto const lexData{[&](std::string_view const elements) {
+            log("parsing `data` ...");
+            std::string const commaSeparated{std::string{elements} + ","};
+            std::string_view rest{commaSeparated};
+            for (uint_t elemNr{1}; rest != ""; ++elemNr) {
+                auto dataError = [&](
+                    std::string const&msg, std::string_view const detail
+                ) {
+                    return fail(msg + " (element number "
+                        + std::to_string(elemNr) + "): "
+                        + std::string{detail}); };
+
+                std::optional<Syntax::DataElement> const oElement{
+                    Syntax::dataElement(rest)};
+                if (!oElement.has_value())
                     return dataError("incomprehensible data element trunk",
-                        commaSeparated);
-                }
-                return true;
-            }},
+                        rest);
+                std::string const unparsedElement{oElement.value().element};
+                std::string unparsedSize{oElement.value().size};
+                std::string unparsedValue{oElement.value().value};
+                rest = oElement.value().rest;
+
+                if (unparsedElement == "")
+                    return dataError("invalid data element", "empty");
+
+                if (unparsedElement.front() == '\"') {
+                    log("parsing string: " + unparsedElement);
+                    std::optional<std::vector<UTF8::rune_t>> const
+                        oRunes{Util::parseString(unparsedElement)};
+                    if (!oRunes.has_value())
+                        return dataError("invalid data string element",
+                            unparsedElement);
+                    for (UTF8::rune_t rune : oRunes.value())
+                        pushData(static_cast<word_t>(rune));
+                    continue; }
+
+                log("parsing non-string: " + unparsedElement);
+
+                if (unparsedSize == "")
+                    unparsedSize = std::string{"1"};
+                std::optional<word_t> const oSize{
+                    Util::stringToOptionalUInt32(unparsedSize)};
+                if (!oSize.has_value())
+                    return dataError("invalid data uint element size",
+                        unparsedSize);
+                log("    ~> size: " + std::to_string(oSize.value()));
+
+                if (std::optional<std::string_view> const oRange{
+                    Syntax::runif(unparsedValue)}; oRange.has_value()
+                ) {
+                    unparsedValue = std::string{oRange.value()};
+                    std::optional<word_t> const oValue{
+                        Util::stringToOptionalUInt32(unparsedValue)};
+                    if (!oValue.has_value())
+                        return dataError("invalid data unif range value",
+                            unparsedValue);
 
-            { "^include ?(" + regexString + ")$"
-            , [&](std::smatch const&smatch) {
-                std::string const includeFilepathString{smatch[1]};
-                std::optional<std::vector<UTF8::rune_t>> oIncludeFilepathRunes{
-                    Util::parseString(includeFilepathString)};
-                if (!oIncludeFilepathRunes.has_value())
-                    return error(filepath, lineNumber, "malformed utf-8 "
-                        "include string: " + includeFilepathString);
-                std::optional<std::string> oIncludeFilepath{
-                    UTF8::utf8string(oIncludeFilepathRunes.value())};
-                if (!oIncludeFilepath.has_value())
-                    return error(filepath, lineNumber, "malformed utf-8 "
-                        "include string: " + includeFilepathString);
-
-                std::filesystem::path const includeFilepath{
-                    filepath.parent_path() / oIncludeFilepath.value()};
-
-                log("including with memPtr = " + std::to_string(memPtr));
-                if (!parseFiles(includeFilepath, memPtr))
-                    return error(filepath, lineNumber, "could not include "
-                        "file: " + includeFilepath.u8string());
-                log("included with memPtr = " + std::to_string(memPtr));
-                return true;
-            }},
+                    push(LexedFile::Unif{oSize.value(), oValue.value()});
+                    continue;
+                }
+                if (unparsedValue == "rperm") {
+                    push(LexedFile::Perm{oSize.value()});
+                    continue;
+                }
 
-            { "^include.*$"
-            , [&](std::smatch const&_) {
-                (void) _;
-                return error(filepath, lineNumber,
-                    "improper include: either empty or missing quotes");
-            }},
+                log("parsing uint: " + unparsedElement);
+
+                if (unparsedValue == "")
+                    unparsedValue = std::string{"0"};
+                std::optional<word_t> const oValue{
+                    Util::stringToOptionalUInt32(unparsedValue)};
+                if (!oValue.has_value())
+                    return dataError("invalid data uint element value",
+                        unparsedValue);
+                log("    ~> value: " + std::to_string(oValue.value()));
+
+                if (oSize.value() == 1)
+                    pushData(oValue.value());
+                else if (oSize.value() != 0)
+                    push(LexedFile::Fill{oValue.value(), oSize.value()});
+            }
+            return true;
+        }};
 
-            { "^profiler ([^ ]*?)(, ?(.*))?$"
-            , [&](std::smatch const&smatch) {
-                std::string const profilerStartStop{smatch[1]};
-                if (profilerStartStop != "start" && profilerStartStop != "stop")
-                    return error(filepath, lineNumber, "invalid profiler "
-                        "directive (must be 'start' or 'stop'): "
-                        + profilerStartStop);
-
-                std::string profilerMessage{smatch[3]};
-                profilerMessage = "file " + filepath.u8string() + ", ln "
-                    + std::to_string(lineNumber)
-                    + std::string{profilerMessage == "" ? "" : ": "}
-                    + profilerMessage;
-
-                if (profiler.size() < memPtr+1)
-                    profiler.resize(memPtr+1);
-                profiler[memPtr].push_back(std::make_tuple(
-                    profilerStartStop == std::string{"start"},
-                    profilerMessage));
+        auto const lexInclude{[&](std::string const&includeFilepathString) {
+            std::optional<std::vector<UTF8::rune_t>> oIncludeFilepathRunes{
+                Util::parseString(includeFilepathString)};
+            if (!oIncludeFilepathRunes.has_value())
+                return fail("malformed utf-8 include string: "
+                    + includeFilepathString);
+            std::optional<std::string> oIncludeFilepath{
+                UTF8::utf8string(oIncludeFilepathRunes.value())};
+            if (!oIncludeFilepath.has_value())
+                return fail("malformed utf-8 include string: "
+                    + includeFilepathString);
+
+            push(LexedFile::Include{oIncludeFilepath.value()});
+            return true;
+        }};
 
-                return true;
-            }},
+        auto const lexProfiler{[&](
+            std::string const&profilerStartStop,
+            std::string const&profilerMessage
+        ) {
+            if (profilerStartStop != "start" && profilerStartStop != "stop")
+                return fail("invalid profiler directive (must be 'start' or "
+                    "'stop'): " + profilerStartStop);
 
-            { "^(" + regexIdentifier + ")( (" + regexValue + "))?$"
-            , [&](std::smatch const&smatch) {
-                auto oName = InstructionNameRepresentationHandler
-                    ::from_string(smatch[1]);
-                if (!oName.has_value())
-                    return error(filepath, lineNumber, "invalid "
-                        "instruction name: " + std::string{smatch[1]});
-                std::optional<std::string> oArg{std::nullopt};
-                if (smatch[3] != "")
-                    oArg = std::optional{smatch[3]};
-                log("pushing instruction: "
-                    + InstructionNameRepresentationHandler
-                        ::toString(oName.value())
-                    + " " + oArg.value_or("(no arg.)"));
-
-                InstructionName const name{oName.value()};
-                InstructionDefinition const idef{instructionDefinitions[
-                    InstructionNameRepresentationHandler::toByteCode(name)]};
-                if (oArg.has_value() && !idef.doesTakeArgument())
-                    return error(filepath, lineNumber,
-                      "instruction takes no argument: "
-                      + InstructionNameRepresentationHandler
-                          ::toString(name));
-                if (
-                    !oArg.has_value() && idef.doesTakeArgument()
-                    && !idef.optionalArgument.has_value()
-                )
-                    return error(filepath, lineNumber, "instruction requires "
-                        "an argument: " + InstructionNameRepresentationHandler
-                            ::toString(name));
-                pushInstruction(name, oArg);
+            push(LexedFile::Profiler{profilerStartStop == "start",
+                profilerMessage});
+            return true;
+        }};
 
-                return true;
-            }},
+        auto const lexInstruction{[&](
+            std::string const&instructionName,
+            std::optional<std::string> const&oArg
+        ) {
+            auto oName = InstructionNameRepresentationHandler
+                ::from_string(instructionName);
+            if (!oName.has_value())
+                return fail("invalid instruction name: " + instructionName);
+            log("pushing instruction: "
+                + InstructionNameRepresentationHandler
+                    ::toString(oName.value())
+                + " " + oArg.value_or("(no arg.)"));
+
+            InstructionName const name{oName.value()};
+            InstructionDefinition const idef{instructionDefinitions[
+                InstructionNameRepresentationHandler::toByteCode(name)]};
+            if (oArg.has_value() && !idef.doesTakeArgument())
+                return fail("instruction takes no argument: "
+                    + InstructionNameRepresentationHandler::toString(name));
+            if (
+                !oArg.has_value() && idef.doesTakeArgument()
+                && !idef.optionalArgument.has_value()
+            )
+                return fail("instruction requires an argument: "
+                    + InstructionNameRepresentationHandler::toString(name));
+            push(LexedFile::Instruction{name, oArg});
 
-        };
+            return true;
+        }};
 
-        auto parseLine{[&](std::string const&_ln) {
-            std::string const ln{[](std::string ln) {
-                ln = std::regex_replace(ln, std::regex{"^;.*$"}, "");
-                ln = std::regex_replace(ln, std::regex{"([^\\\\]);.*$"}, "$1");
-                ln = std::regex_replace(ln, std::regex{"\\s+"}, " ");
-                ln = std::regex_replace(ln, std::regex{"^ +"}, "");
-                ln = std::regex_replace(ln, std::regex{" +$"}, "");
-                return ln;
-            }(_ln)};
+        /* the line forms, tried in order (see `Syntax`) */
+        auto lexLine{[&](std::string_view const _ln) {
+            std::string const ln{Syntax::normalize(_ln)};
             if (ln == "")
                 return true;
 
             log("ln " + std::to_string(lineNumber) + ": " + ln);
 
-            for (auto const&[regexString, f] : onMatch) {
-                std::smatch smatch{};
-                if (std::regex_match(ln, smatch, std::regex{regexString}))
-                    return f(smatch);
-            }
+            if (auto const oDef{Syntax::definition(ln)}; oDef.has_value()) {
+                push(LexedFile::Definition{std::string{oDef.value().name},
+                    std::string{oDef.value().value}});
+                return true; }
 
-            return false;
+            if (auto const oLabel{Syntax::label(ln)}; oLabel.has_value()) {
+                push(LexedFile::Label{std::string{oLabel.value()}});
+                return true; }
+
+            if (auto const oData{Syntax::data(ln)}; oData.has_value())
+                return lexData(oData.value());
+
+            if (auto const oInclude{Syntax::include(ln)}; oInclude.has_value())
+                return lexInclude(std::string{oInclude.value()});
+            if (Syntax::improperInclude(ln))
+                return fail("improper include: either empty or missing "
+                    "quotes");
+
+            if (auto const oProfiler{Syntax::profiler(ln)};
+                oProfiler.has_value())
+                return lexProfiler(
+                    std::string{oProfiler.value().startStop},
+                    std::string{oProfiler.value().message});
+
+            if (auto const oInstruction{Syntax::instruction(ln)};
+                oInstruction.has_value()
+            ) {
+                std::optional<std::string> oArg{std::nullopt};
+                if (oInstruction.value().argument.has_value())
+                    oArg = std::make_optional(std::string{
+                        oInstruction.value().argument.value()});
+                return lexInstruction(
+                    std::string{oInstruction.value().name}, oArg); }
+
+            return fail(std::nullopt);
         }};
 
-        for (; std::getline(f, ln); ++lineNumber)
-            if (!parseLine(ln))
-                return error(filepath, lineNumber, "incomprehensible");
-        memorySize = memPtr;
+        /* as with `std::getline`, a final newline does not end an empty
+           line; lexing stops at the first incomprehensible line */
+        for (std::size_t p{0}; p < contents.size(); ++lineNumber) {
+            std::size_t const q{std::min(contents.find('\n', p),
+                contents.size())};
+            if (!lexLine(contents.substr(p, q - p)))
+                break;
+            p = q + 1; }
 
-        return true;
-    }
+        return lexed; }
 
     private: bool pragmas(std::filesystem::path const&filepath) {
         auto const flag{[&](
@@ -466,7 +762,8 @@ class Parser {
                     if (m < memorySize)
                         return error(filepath, lineNumber, "memory size "
                             "smaller than minimal required");
-                    memorySize = m; }
+                    memorySize = m;
+                    pragmaMemorySize = std::make_optional(m); }
                 return true;
             }},
 
@@ -488,119 +785,175 @@ class Parser {
         return true;
     }
 
-    private: std::optional<std::vector<MemorySemantic>>
-    constructMemorySemantics() const {
+    /* the number of data words a parsed piece holds */
+    private: static word_t dataWords(ParsedPiece const&piece) {
+        if (std::holds_alternative<ParsedInstruction>(piece.piece))
+            return 0;
+        if (ParsedFill const*const fill{std::get_if<ParsedFill>(&piece.piece)})
+            return fill->count;
+        return std::get<ParsedBlob>(piece.piece).count; }
+
+    /* the number of bytes a parsed piece occupies in memory */
+    private: static word_t width(ParsedPiece const&piece) {
+        if (std::holds_alternative<ParsedInstruction>(piece.piece))
+            return 5;
+        return 4*dataWords(piece); }
+
+    private: std::optional<SemanticMap> constructMemorySemantics() const {
         if (!pragmaStaticProgram)
             return std::nullopt;
 
-        std::vector<MemorySemantic> memorySemantics{};
+        SemanticMap memorySemantics{};
         memorySemantics.reserve(memorySize);
-        for (auto const&[filepath, lineNumber, p] : parsing) {
-            if (std::holds_alternative<parsingData>(p)) {
+        for (ParsedPiece const&piece : parsing) {
+            if (std::holds_alternative<ParsedInstruction>(piece.piece)) {
+                memorySemantics.push_back(MemorySemantic::InstructionHead);
+                for (std::size_t j{0}; j < 4; j++)
+                    memorySemantics.push_back(MemorySemantic::Instruction);
+                continue; }
+
+            for (word_t k{0}; k < dataWords(piece); ++k) {
                 memorySemantics.push_back(MemorySemantic::DataHead);
                 for (std::size_t j{0}; j < 3; j++)
                     memorySemantics.push_back(MemorySemantic::Data); }
-            else if (std::holds_alternative<parsingInstruction>(p)) {
-                memorySemantics.push_back(MemorySemantic::InstructionHead);
-                for (std::size_t j{0}; j < 4; j++)
-                    memorySemantics.push_back(MemorySemantic::Instruction); }
-            else {
-                error("internal error (memory semantics): parsing piece holds "
-                    "invalid alternative");
-                return std::nullopt; }
         }
 
         return std::make_optional(memorySemantics);
     }
 
-    private: bool parseAssemble(ComputationState &cs) {
+    /* Resolves an instruction's argument to its value: a definition's name
+       is replaced by its value, which then is either a character literal
+       or a number. Labels are defined as `@`-prefixed definitions, such
+       that a remaining `@` refers to an undefined label. */
+    private: bool resolveArgument(
+        SourceLocation const&location, std::string arg,
+        std::optional<word_t> &oValue
+    ) const {
+        if (auto const it{definitions.find(arg)}; it != definitions.end()) {
+            auto const&[_, definition]{it->second};
+            arg = definition; }
+
+        if (arg == "")
+            return error(location, "no instruction argument");
+        if (arg.front() == '@') {
+            std::string label{arg};
+            label.erase(label.begin());
+
+            std::vector<std::string> unsortedLabels{};
+            for (auto const&[lbl, _] : definitions)
+                unsortedLabels.push_back(lbl);
+            std::vector<std::string> const sortedLabels{
+                Util::closestByLevenshteinDistanceTo(unsortedLabels, label, 3)};
+            std::string msg{"label @" + label + " was not defined; "
+                "did you possibly mean one of the following defined labels?"};
+            for (std::size_t j{0}; j < sortedLabels.size() && j < 3; ++j)
+                msg += "\n    " + std::to_string(j+1) + ") "
+                    + sortedLabels[j];
+            if (sortedLabels.empty())
+                msg += "\n    (no labels have been defined)";
+            return error(location, msg);
+        }
+
+        if (arg.front() == '\'') {
+            if (arg.size() < 2 || arg.back() != '\'')
+                return error(location, "invalid character literal");
+            std::string s{arg};
+            s.front() = s.back() = '"';
+            std::optional<std::vector<UTF8::rune_t>> oRunes{
+                Util::parseString(s)};
+            if (oRunes.has_value() && oRunes.value().size() != 1)
+                oRunes = std::nullopt;
+            if (!oRunes.has_value())
+                return error(location, "invalid character literal");
+            oValue = std::make_optional(static_cast<word_t>(
+                oRunes.value()[0]));
+            return true;
+        }
+
+        oValue = static_cast<std::optional<word_t>>(
+            Util::stringToOptionalUInt32(arg));
+        if (!oValue.has_value())
+            return error(location, "invalid argument value: " + arg);
+        return true;
+    }
+
+    /* assembles into `cs`; when assembling a `module`, label arguments
+       are recorded as relocations and the final checks are left to the
+       linker */
+    private: bool parseAssemble(
+        ComputationState &cs, Module *const module=nullptr
+    ) {
         bool memPtrGTStackBeginningAndNonDataOccurred{false};
         bool haltInstructionWasUsed{false};
 
+        /* every distinct argument is resolved once */
+        std::vector<std::optional<word_t>> resolved(symbols.size());
+
+        SourceMap &sourceMap{cs.debug.sourceMap};
+        sourceMap.files = files;
+        sourceMap.lines.reserve(parsing.size());
+        for (auto const&[name, definition] : definitions)
+            if (name.front() == '@')
+                sourceMap.labels.emplace_back(static_cast<word_t>(
+                    std::stoul(std::get<1>(definition))), name.substr(1));
+        std::sort(sourceMap.labels.begin(), sourceMap.labels.end());
+
         word_t memPtr{0};
-        for (auto const&[filepath, lineNumber, p] : parsing) {
-            if (std::holds_alternative<parsingData>(p)) {
-                word_t data{std::get<parsingData>(p)};
-                log("data value 0x" + Util::UInt32AsPaddedHex(data));
+        for (ParsedPiece const&piece : parsing) {
+            SourceLocation const&location{piece.location};
+            sourceMap.lines.push_back(SourceLine{memPtr, width(piece),
+                location.file, location.line,
+                std::holds_alternative<ParsedInstruction>(piece.piece)});
+
+            if (!std::holds_alternative<ParsedInstruction>(piece.piece)) {
+                ParsedFill const*const fill{
+                    std::get_if<ParsedFill>(&piece.piece)};
+                word_t const*const words{fill != nullptr ? &fill->value
+                    : blobs.data() + std::get<ParsedBlob>(piece.piece).offset};
+                word_t const count{dataWords(piece)};
+                log("data value 0x" + Util::UInt32AsPaddedHex(words[0])
+                    + (count > 1 ? " (" + std::to_string(count) + " words)"
+                        : ""));
                 try {
-                    memPtr += cs.storeData(memPtr, data);
+                    memPtr += cs.storeDataBlock(memPtr, words, count,
+                        fill != nullptr);
                 } catch (std::runtime_error const&e) {
-                    return error(filepath, lineNumber,
+                    return error(location,
                         std::string{"failed to store data: "} + e.what());
                 }
 
                 if (!memPtrGTStackBeginningAndNonDataOccurred)
                     stackEnd = std::make_optional(memPtr);
-            } else if (std::holds_alternative<parsingInstruction>(p)) {
+            } else {
                 if (memPtr > stackBeginning)
                     memPtrGTStackBeginningAndNonDataOccurred = true;
 
-                auto [name, oArg]{std::get<parsingInstruction>(p)};
+                auto const&[name, oSymbol]{
+                    std::get<ParsedInstruction>(piece.piece)};
                 std::optional<word_t> oValue{std::nullopt};
-                if (oArg.has_value()) {
-                    if (Util::std20::contains(definitions, oArg.value())) {
-                        auto const&[_, definition]{definitions[oArg.value()]};
-                        oArg = std::make_optional(definition); }
-
-                    if (oArg.value() == "")
-                        return error(filepath, lineNumber,
-                            "no instruction argument");
-                    if (oArg.value().front() == '@') {
-                        std::string label{oArg.value()};
-                        label.erase(label.begin());
-
-                        std::vector<std::string> unsortedLabels{};
-                        for (auto const&[lbl, _] : definitions)
-                            unsortedLabels.push_back(lbl);
-                        std::vector<std::string> const sortedLabels{
-                            Util::sortByLevenshteinDistanceTo(
-                                unsortedLabels, label)};
-                        std::string msg{"label @" + label + " was not defined; "
-                            "did you possibly mean one of the following "
-                            "defined labels?"};
-                        for (
-                            std::size_t j{0};
-                            j < sortedLabels.size() && j < 3;
-                            ++j
-                        )
-                            msg += "\n    " + std::to_string(j+1) + ") "
-                                + sortedLabels[j];
-                        if (sortedLabels.empty())
-                            msg += "\n    (no labels have been defined)";
-                        return error(filepath, lineNumber, msg);
-                    }
-
-                    if (oArg.value().front() == '\'') {
-                        if (
-                            oArg.value().size() < 2
-                            || oArg.value().back() != '\''
-                        )
-                            return error(filepath, lineNumber,
-                                "invalid character literal");
-                        std::string s{oArg.value()};
-                        s.front() = s.back() = '"';
-                        std::optional<std::vector<UTF8::rune_t>> oRunes{
-                            Util::parseString(s)};
-                        if (oRunes.has_value() && oRunes.value().size() != 1)
-                            oRunes = std::nullopt;
-                        if (!oRunes.has_value())
-                            return error(filepath, lineNumber,
-                                "invalid character literal");
-                        oValue = std::make_optional(static_cast<word_t>(
-                            oRunes.value()[0]));
-                    } else {
-                        oValue = static_cast<std::optional<word_t>>(
-                            Util::stringToOptionalUInt32(oArg.value()));
-                        if (!oValue.has_value())
-                            return error(filepath, lineNumber,
-                                "invalid argument value: " + oArg.value());
-                    }
+                if (module != nullptr && oSymbol.has_value()
+                    && symbols[oSymbol.value()].front() == '@'
+                ) {
+                    std::string const&label{symbols[oSymbol.value()]};
+                    if (Util::std20::contains(definitions, label))
+                        module->relocations.push_back(Module::Relocation{
+                            memPtr, std::nullopt});
+                    else {
+                        module->relocations.push_back(Module::Relocation{
+                            memPtr, std::make_optional(label.substr(1))});
+                        oValue = std::make_optional(word_t{0}); }
                 }
+                if (oSymbol.has_value() && !oValue.has_value()) {
+                    std::optional<word_t> &oResolved{resolved[oSymbol.value()]};
+                    if (!oResolved.has_value() && !resolveArgument(location,
+                        symbols[oSymbol.value()], oResolved))
+                        return false;
+                    oValue = oResolved; }
 
                 InstructionDefinition const idef{instructionDefinitions[
                     InstructionNameRepresentationHandler::toByteCode(name)]};
                 if (!idef.doesTakeArgument() && oValue.has_value())
-                    return error(filepath, lineNumber, "superfluous argument: "
+                    return error(location, "superfluous argument: "
                         + InstructionNameRepresentationHandler::toString(name)
                         + " " + std::to_string(oValue.value()));
                 if (idef.doesTakeArgument()) {
@@ -608,7 +961,7 @@ class Parser {
                         !idef.optionalArgument.has_value()
                         && !oValue.has_value()
                     )
-                        return error(filepath, lineNumber, "requiring "
+                        return error(location, "requiring "
                             "argument: " + InstructionNameRepresentationHandler
                                 ::toString(name));
                     if (!oValue.has_value())
@@ -622,7 +975,7 @@ class Parser {
                 try {
                     memPtr += cs.storeInstruction(memPtr, instruction);
                 } catch (std::runtime_error const&e) {
-                    return error(filepath, lineNumber,
+                    return error(location,
                         std::string{"failed to store instruction: "}
                         + e.what());
                 }
@@ -630,15 +983,17 @@ class Parser {
                 haltInstructionWasUsed |= InstructionName::HLT == name;
                 stackInstructionWasUsed |= InstructionNameRepresentationHandler
                     ::doesPointAtStack(name);
-            } else
-                return error("internal error: parsing piece holds invalid "
-                    "alternative");
+            }
         }
 
-        if (!haltInstructionWasUsed)
+        if (module != nullptr) {
+            module->haltInstructionWasUsed = haltInstructionWasUsed;
+            module->stackInstructionWasUsed = stackInstructionWasUsed; }
+        else if (!haltInstructionWasUsed)
             return error("no halt instruction was used");
 
-        if (pragmaStaticStackCheck && stackInstructionWasUsed)
+        if (module == nullptr && pragmaStaticStackCheck
+            && stackInstructionWasUsed)
             if (!Util::std20::contains(definitions, std::string{"@stack"}))
                 return error("stack instructions are used yet no stack was "
                     "defined");
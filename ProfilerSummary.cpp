@@ -0,0 +1,93 @@
+#ifndef JOY_ASSEMBLER__PROFILER_SUMMARY_CPP
+#define JOY_ASSEMBLER__PROFILER_SUMMARY_CPP
+
+#include "Includes.hpp"
+
+/* Reports every profiler region once a program stopped: how often it was
+   passed and the fewest, mean, most and total instructions and
+   micro-instructions executed within it, either as a table or as JSON. */
+class ProfilerSummary {
+    public: static void table(
+        std::ostream &os, std::vector<ProfilerRegion> const&regions
+    ) {
+        os << "profiler: " << regions.size() << " regions\n"
+           << Util::pad("hits", 12) << std::string(10, ' ')
+           << Util::pad("min", 12) << Util::pad("mean", 12)
+           << Util::pad("max", 12) << Util::pad("total", 13) << "  region\n";
+        for (ProfilerRegion const&region : regions) {
+            os << Util::pad(std::to_string(region.hits), 12)
+               << row("instr.", region.hits, region.total.nInstructions,
+                   region.minimum.nInstructions, region.maximum.nInstructions)
+               << "  " << region.name << "\n"
+               << std::string(12, ' ')
+               << row("micro", region.hits, region.total.nMicroInstructions,
+                   region.minimum.nMicroInstructions,
+                   region.maximum.nMicroInstructions)
+               << "\n"; }
+        os << std::flush;
+    }
+
+    public: static void json(
+        std::ostream &os, std::vector<ProfilerRegion> const&regions
+    ) {
+        auto const statistics{[&](
+            ProfilerRegion const&region,
+            uint_t ComputationStateStatistics::*const count
+        ) {
+            return "{\"min\": " + std::to_string(region.hits == 0 ? 0
+                    : region.minimum.*count)
+                + ", \"mean\": " + mean(region.total.*count, region.hits)
+                + ", \"max\": " + std::to_string(region.maximum.*count)
+                + ", \"total\": " + std::to_string(region.total.*count)
+                + "}"; }};
+
+        os << "{\"regions\": [";
+        for (std::size_t j{0}; j < regions.size(); ++j) {
+            ProfilerRegion const&region{regions[j]};
+            os << (j == 0 ? "\n" : ",\n")
+               << "  {\"name\": " << quote(region.name)
+               << ", \"hits\": " << region.hits
+               << ", \"instructions\": " << statistics(region,
+                   &ComputationStateStatistics::nInstructions)
+               << ", \"microInstructions\": " << statistics(region,
+                   &ComputationStateStatistics::nMicroInstructions)
+               << "}"; }
+        os << "\n]}" << std::endl;
+    }
+
+    private: static std::string row(
+        std::string const&metric, uint_t const hits, uint_t const total,
+        uint_t const minimum, uint_t const maximum
+    ) {
+        if (hits == 0)
+            return "  " + metric + std::string(8 - metric.size(), ' ')
+                + Util::pad("-", 12) + Util::pad("-", 12) + Util::pad("-", 12)
+                + Util::pad("0", 13);
+        return "  " + metric + std::string(8 - metric.size(), ' ')
+            + Util::pad(std::to_string(minimum), 12)
+            + Util::pad(mean(total, hits), 12)
+            + Util::pad(std::to_string(maximum), 12)
+            + Util::pad(std::to_string(total), 13); }
+
+    /* to one decimal place */
+    private: static std::string mean(uint_t const total, uint_t const hits) {
+        if (hits == 0)
+            return "0.0";
+        uint_t const tenths{(total * 10 + hits/2) / hits};
+        return std::to_string(tenths / 10) + "."
+            + std::to_string(tenths % 10); }
+
+    private: static std::string quote(std::string const&s) {
+        std::string quoted{"\""};
+        for (char const c : s) {
+            if (c == '"' || c == '\\')
+                quoted += std::string{'\\', c};
+            else if (static_cast<byte_t>(c) < 0x20)
+                quoted += "\\u00" + Util::UInt8AsPaddedHex(
+                    static_cast<byte_t>(c));
+            else
+                quoted += c; }
+        return quoted + "\""; }
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "Types.hpp"
 #include "Util.cpp"
+#include "Memory.cpp"
 
 namespace InstructionNameRepresentationHandler {
 
@@ -68,6 +69,33 @@ namespace InstructionNameRepresentationHandler {
             InstructionName::JE, InstructionName::JNE,
         }, name);
     }
+    bool isConditionalJump(InstructionName const name) {
+        return name != InstructionName::JMP && doesPointAtInstruction(name);
+    }
+
+    /* whether the conditional jump `name` is taken given register A; the
+       execution engines and `BranchProfile` decide it alike */
+    constexpr bool jumps(InstructionName const name, word_t const registerA) {
+        bool const negative{Util::fromTwo_sComplement<uint32_t, int32_t, 32>(
+            registerA) < 0};
+        if (name == InstructionName::JN)
+            return negative;
+        if (name == InstructionName::JNN)
+            return !negative;
+        if (name == InstructionName::JZ)
+            return registerA == 0;
+        if (name == InstructionName::JNZ)
+            return registerA != 0;
+        if (name == InstructionName::JP)
+            return !negative && registerA != 0;
+        if (name == InstructionName::JNP)
+            return negative || registerA == 0;
+        if (name == InstructionName::JE)
+            return registerA % 2 == 0;
+        if (name == InstructionName::JNE)
+            return registerA % 2 != 0;
+        return false;
+    }
 
     namespace MicroInstructionsUtil {
         /* TODO `constexpr` causes an internal compiler error */
@@ -101,14 +129,14 @@ namespace InstructionRepresentationHandler {
     }
 
     std::optional<std::string> staticallyValidInstruction(
-        std::vector<MemorySemantic> const&memorySemantics,
+        SemanticMap const&memorySemantics,
         Instruction const&instruction
     ) {
         if (
             InstructionNameRepresentationHandler
                 ::doesPointAtData(instruction.name)
         ) {
-            if (instruction.argument+3 >= memorySemantics.size())
+            if (std::size_t{instruction.argument}+3 >= memorySemantics.size())
                 return std::make_optional("static analysis detected an "
                     "out-of-bounds data error");
             if (
@@ -147,7 +175,7 @@ namespace InstructionRepresentationHandler {
             InstructionNameRepresentationHandler
                 ::doesPointAtInstruction(instruction.name)
         ) {
-            if (instruction.argument+4 >= memorySemantics.size())
+            if (std::size_t{instruction.argument}+4 >= memorySemantics.size())
                 return std::make_optional("static analysis detected an "
                     "out-of-bounds instruction error");
             if (
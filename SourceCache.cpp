@@ -0,0 +1,331 @@
+#ifndef JOY_ASSEMBLER__SOURCE_CACHE_CPP
+#define JOY_ASSEMBLER__SOURCE_CACHE_CPP
+
+#include "Includes.hpp"
+
+/* A source file's lines as recognized by `Parser::lex`. Recognizing a line
+   depends on nothing but the line, whereas what it assembles to depends on
+   where it is placed, on what was parsed before it and on the random
+   number engine; the latter is left to `Parser::parseFiles`. */
+struct LexedFile {
+    struct Definition { std::string name, value; };
+    struct Label { std::string name; };
+    /* data words, consecutive on one line */
+    struct Words { std::vector<word_t> words; };
+    struct Fill { word_t value, count; };
+    struct Unif { word_t count, range; };
+    struct Perm { word_t count; };
+    /* the path as written, relative to the including file */
+    struct Include { std::string filepath; };
+    struct Profiler { bool start; std::string message; };
+    struct Instruction {
+        InstructionName name;
+        std::optional<std::string> argument;
+    };
+    /* an incomprehensible line, possibly with a more specific message */
+    struct Error { std::optional<std::string> message; };
+
+    using Line = std::variant<Definition, Label, Words, Fill, Unif, Perm,
+        Include, Profiler, Instruction, Error>;
+
+    /* blank lines are left out */
+    std::vector<std::tuple<uint32_t, Line>> lines{};
+};
+
+/* Lexed files kept on disk, keyed by a hash of their contents; since
+   hashes may collide, each entry also holds the contents it was lexed
+   from, which have to match on loading. The directory is
+   `$XDG_CACHE_HOME/joy-assembler`, defaulting to `~/.cache/joy-assembler`.
+   Without either environment variable or with `JOY_ASSEMBLER_NO_CACHE`
+   set, nothing is cached. A cache entry which cannot be read is treated
+   as missing; entries are written to a temporary file first, such that
+   concurrent assemblers never see a partial one. Once the entries exceed
+   the cache's capacity, the least recently used ones are removed. */
+class SourceCache {
+    private:
+        /* part of every key; to be bumped whenever lexing or entries change */
+        static word_t constexpr version{2};
+
+        std::optional<std::filesystem::path> oDirectory;
+        /* in bytes, summed over all entries */
+        uint_t capacity;
+
+    public: static uint_t constexpr defaultCapacity{uint_t{64} << 20};
+
+    public: SourceCache(uint_t const capacity=defaultCapacity) :
+        oDirectory{directory()},
+        capacity{capacity}
+    { ; }
+
+    public: std::optional<LexedFile> load(
+        std::string_view const contents
+    ) const {
+        if (!oDirectory.has_value())
+            return std::nullopt;
+        std::filesystem::path const entry{oDirectory.value() / key(contents)};
+
+        std::error_code ec{};
+        if (!std::filesystem::is_regular_file(entry, ec))
+            return std::nullopt;
+        std::ifstream is{entry, std::ios::binary};
+        if (!is)
+            return std::nullopt;
+        std::vector<byte_t> const bytes{std::istreambuf_iterator<char>{is},
+            std::istreambuf_iterator<char>{}};
+
+        try {
+            LexedFile lexed{read(bytes, contents)};
+            /* marks the entry as recently used */
+            std::filesystem::last_write_time(entry,
+                std::filesystem::file_time_type::clock::now(), ec);
+            return std::make_optional(std::move(lexed));
+        } catch (std::runtime_error const&) {
+            return std::nullopt; }
+    }
+
+    public: void store(
+        std::string_view const contents, LexedFile const&lexed
+    ) const {
+        if (!oDirectory.has_value())
+            return;
+        std::error_code ec{};
+        std::filesystem::create_directories(oDirectory.value(), ec);
+        if (ec)
+            return;
+
+        std::filesystem::path const entry{oDirectory.value() / key(contents)};
+        std::filesystem::path temporary{entry};
+        temporary += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream out{temporary, std::ios::binary};
+            out << write(lexed, contents);
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temporary, ec);
+                return; }
+        }
+        std::filesystem::rename(temporary, entry, ec);
+        if (ec)
+            std::filesystem::remove(temporary, ec);
+        else
+            evict();
+    }
+
+    /* removes the least recently used entries until the rest fit */
+    private: void evict() const {
+        std::vector<std::tuple<std::filesystem::file_time_type, uint_t,
+            std::filesystem::path>> entries{};
+        uint_t total{0};
+        std::error_code ec{};
+        for (std::filesystem::directory_iterator it{oDirectory.value(), ec};
+            !ec && it != std::filesystem::directory_iterator{};
+            it.increment(ec)
+        ) {
+            std::filesystem::path const&entry{it->path()};
+            if (entry.extension() != ".joyl")
+                continue;
+            std::error_code sizeEc{}, timeEc{};
+            uint_t const size{std::filesystem::file_size(entry, sizeEc)};
+            std::filesystem::file_time_type const time{
+                std::filesystem::last_write_time(entry, timeEc)};
+            if (sizeEc || timeEc)
+                continue;
+            total += size;
+            entries.emplace_back(time, size, entry); }
+        if (total <= capacity)
+            return;
+
+        std::sort(entries.begin(), entries.end());
+        for (auto const&[_, size, entry] : entries) {
+            if (total <= capacity)
+                break;
+            if (std::filesystem::remove(entry, ec))
+                total -= size; }
+    }
+
+    private: static std::optional<std::filesystem::path> directory() {
+        if (std::getenv("JOY_ASSEMBLER_NO_CACHE") != nullptr)
+            return std::nullopt;
+        char const*const xdg{std::getenv("XDG_CACHE_HOME")};
+        if (xdg != nullptr && std::filesystem::path{xdg}.is_absolute())
+            return std::make_optional(
+                std::filesystem::path{xdg} / "joy-assembler");
+        char const*const home{std::getenv("HOME")};
+        if (home != nullptr && std::filesystem::path{home}.is_absolute())
+            return std::make_optional(
+                std::filesystem::path{home} / ".cache" / "joy-assembler");
+        return std::nullopt; }
+
+    /* FNV-1a over the contents, together with their length */
+    private: static std::string key(std::string_view const contents) {
+        uint64_t hash{0xcbf29ce484222325};
+        for (char const c : contents) {
+            hash ^= static_cast<byte_t>(c);
+            hash *= 0x100000001b3; }
+        return Util::UInt32AsPaddedHex(static_cast<uint32_t>(hash >> 32))
+            + Util::UInt32AsPaddedHex(static_cast<uint32_t>(hash))
+            + "-" + std::to_string(contents.size())
+            + "-v" + std::to_string(version) + ".joyl"; }
+
+    private: enum class Tag : byte_t {
+        Definition, Label, Words, Fill, Unif, Perm, Include, Profiler,
+        Instruction, Error
+    };
+
+    private: static std::string write(
+        LexedFile const&lexed, std::string_view const contents
+    ) {
+        ObjectFile::Writer w{};
+        w.raw(reinterpret_cast<byte_t const*>("JOYL"), 4);
+        w.u32(version);
+        w.u64(contents.size());
+        w.raw(reinterpret_cast<byte_t const*>(contents.data()),
+            contents.size());
+        w.u64(lexed.lines.size());
+        for (auto const&[lineNumber, line] : lexed.lines) {
+            w.u32(lineNumber);
+            w.u8(static_cast<byte_t>(line.index()));
+            std::visit([&](auto const&ln) { write(w, ln); }, line); }
+        return w.str(); }
+
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Definition const&ln
+    ) {
+        w.string(ln.name);
+        w.string(ln.value); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Label const&ln
+    ) {
+        w.string(ln.name); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Words const&ln
+    ) {
+        w.u32(static_cast<word_t>(ln.words.size()));
+        for (word_t const word : ln.words)
+            w.u32(word); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Fill const&ln
+    ) {
+        w.u32(ln.value);
+        w.u32(ln.count); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Unif const&ln
+    ) {
+        w.u32(ln.count);
+        w.u32(ln.range); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Perm const&ln
+    ) {
+        w.u32(ln.count); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Include const&ln
+    ) {
+        w.string(ln.filepath); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Profiler const&ln
+    ) {
+        w.u8(ln.start ? 1 : 0);
+        w.string(ln.message); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Instruction const&ln
+    ) {
+        w.u8(InstructionNameRepresentationHandler::toByteCode(ln.name));
+        writeOptional(w, ln.argument); }
+    private: static void write(
+        ObjectFile::Writer &w, LexedFile::Error const&ln
+    ) {
+        writeOptional(w, ln.message); }
+
+    private: static void writeOptional(
+        ObjectFile::Writer &w, std::optional<std::string> const&o
+    ) {
+        w.u8(o.has_value() ? 1 : 0);
+        if (o.has_value())
+            w.string(o.value()); }
+
+    private: static std::optional<std::string> readOptional(
+        ObjectFile::Reader &r
+    ) {
+        if (r.u8() == 0)
+            return std::nullopt;
+        return std::make_optional(r.string()); }
+
+    private: static LexedFile read(
+        std::vector<byte_t> const&bytes, std::string_view const contents
+    ) {
+        ObjectFile::Reader r{bytes.data(), bytes.size()};
+        if (bytes.size() < 4 || std::memcmp(r.raw(4), "JOYL", 4) != 0
+            || r.u32() != version || r.u64() != contents.size())
+            throw std::runtime_error{"not a cache entry"};
+        if (std::memcmp(r.raw(contents.size()), contents.data(),
+            contents.size()) != 0)
+            throw std::runtime_error{"a cache entry of other contents"};
+
+        LexedFile lexed{};
+        uint_t const nLines{r.u64()};
+        for (uint_t j{0}; j < nLines; ++j) {
+            uint32_t const lineNumber{r.u32()};
+            switch (static_cast<Tag>(r.u8())) {
+                case Tag::Definition: {
+                    std::string name{r.string()};
+                    lexed.lines.emplace_back(lineNumber, LexedFile::Definition{
+                        std::move(name), r.string()});
+                    break; }
+                case Tag::Label:
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Label{r.string()});
+                    break;
+                case Tag::Words: {
+                    word_t const n{r.u32()};
+                    if (n > r.remaining() / 4)
+                        throw std::runtime_error{"truncated cache entry"};
+                    std::vector<word_t> words(n);
+                    for (word_t &word : words)
+                        word = r.u32();
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Words{std::move(words)});
+                    break; }
+                case Tag::Fill: {
+                    word_t const value{r.u32()};
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Fill{value, r.u32()});
+                    break; }
+                case Tag::Unif: {
+                    word_t const count{r.u32()};
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Unif{count, r.u32()});
+                    break; }
+                case Tag::Perm:
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Perm{r.u32()});
+                    break;
+                case Tag::Include:
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Include{r.string()});
+                    break;
+                case Tag::Profiler: {
+                    bool const start{r.u8() != 0};
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Profiler{start, r.string()});
+                    break; }
+                case Tag::Instruction: {
+                    InstructionName const name{
+                        InstructionNameRepresentationHandler::fromByteCode(
+                            r.u8())};
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Instruction{name, readOptional(r)});
+                    break; }
+                case Tag::Error:
+                    lexed.lines.emplace_back(lineNumber,
+                        LexedFile::Error{readOptional(r)});
+                    break;
+                default:
+                    throw std::runtime_error{"invalid cache entry"};
+            }
+        }
+        if (r.remaining() != 0)
+            throw std::runtime_error{"invalid cache entry"};
+        return lexed; }
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef JOY_ASSEMBLER__SOURCE_LOCATIONS_CPP
+#define JOY_ASSEMBLER__SOURCE_LOCATIONS_CPP
+
+#include "Includes.hpp"
+
+/* Names addresses by the source lines they were assembled from, as the
+   reports listing addresses do. */
+class SourceLocations {
+    /* each address's file and line, followed by the line's source text
+       in a column of its own; the address itself if no instruction was
+       assembled to it */
+    public: static std::vector<std::string> locate(
+        SourceMap const&sourceMap, std::vector<word_t> const&addresses
+    ) {
+        std::unordered_map<word_t, SourceLine> sourceAt{};
+        for (SourceLine const&ln : sourceMap.lines)
+            if (ln.instruction)
+                sourceAt.emplace(ln.address, ln);
+
+        std::vector<std::tuple<std::string, std::string>> columns{};
+        std::map<uint32_t, std::vector<std::string>> files{};
+        std::size_t width{0};
+        for (word_t const address : addresses) {
+            std::string location{"0x" + Util::UInt32AsPaddedHex(address)};
+            std::string text{};
+            if (auto const it{sourceAt.find(address)}; it != sourceAt.end()) {
+                SourceLine const&ln{it->second};
+                location = relative(sourceMap.files.at(ln.file)) + ":"
+                    + std::to_string(ln.line);
+                if (!Util::std20::contains(files, ln.file))
+                    files.emplace(ln.file, lines(sourceMap.files.at(ln.file)));
+                std::vector<std::string> const&file{files.at(ln.file)};
+                if (ln.line >= 1 && ln.line <= file.size())
+                    text = file[ln.line-1]; }
+            width = std::max(width, location.size());
+            columns.emplace_back(location, text);
+        }
+
+        std::vector<std::string> sources{};
+        for (auto const&[location, text] : columns)
+            sources.push_back(location + (text.empty() ? "" : std::string(
+                width - location.size() + 2, ' ') + text));
+        return sources; }
+
+    /* relative to the working directory if below it */
+    private: static std::string relative(std::filesystem::path const&path) {
+        std::error_code ec{};
+        std::filesystem::path const rel{std::filesystem::relative(path, ec)};
+        if (ec || rel.empty() || *rel.begin() == "..")
+            return path.string();
+        return rel.string(); }
+
+    /* a source file's lines without surrounding whitespace; none if it
+       cannot be read (anymore) */
+    private: static std::vector<std::string> lines(
+        std::filesystem::path const&path
+    ) {
+        std::vector<std::string> lines{};
+        std::ifstream is{path};
+        for (std::string ln{}; std::getline(is, ln); ) {
+            std::size_t const begin{ln.find_first_not_of(" \t")};
+            std::size_t const end{ln.find_last_not_of(" \t\r")};
+            lines.push_back(begin == std::string::npos ? std::string{}
+                : ln.substr(begin, end - begin + 1)); }
+        return lines; }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef JOY_ASSEMBLER__STACK_ANALYSIS_CPP
+#define JOY_ASSEMBLER__STACK_ANALYSIS_CPP
+
+#include "Includes.hpp"
+
+/* Bounds how deep the stack of a static program can grow. Every path
+   through every function -- the code entered at the program's start or by
+   `CAL` -- is followed, tracking `SC` relative to where it was when the
+   function was entered; each instruction has to be reached with the same
+   relative `SC` on every path and each `RET` with a balanced stack. The
+   depths at which functions are entered then follow from the call graph.
+   No bound is given whenever the program does anything the analysis
+   cannot follow: recursion, computed jumps (`SPC`), setting `SC` (`SSC`),
+   storing into the stack other than through stack instructions (`SIA`
+   included, whose target is unknown), overwriting a return address, or
+   underflowing the stack. */
+class StackAnalysis {
+    public: using Code = DecodedInstructions;
+
+    private:
+        struct Function {
+            /* callees, each with `SC` relative to this function's entry
+               at the call */
+            std::vector<std::tuple<word_t, int64_t>> calls{};
+            /* the lowest and one past the highest stack byte accessed and
+               the lowest one written, relative to entry */
+            int64_t lowest{0}, highest{0}, lowestWrite{0};
+            /* bounds on the absolute depth at entry */
+            int64_t minimumEntry{std::numeric_limits<int64_t>::max()};
+            int64_t maximumEntry{std::numeric_limits<int64_t>::min()};
+        };
+
+        Code const&code;
+        word_t const stackBegin, stackEnd;
+        std::map<word_t, Function> functions;
+        /* the function each reached instruction belongs to and `SC`
+           relative to that function's entry */
+        std::unordered_map<word_t, std::tuple<word_t, int64_t>> reached;
+
+    /* The number of bytes above `stackBegin` the program may access, if
+       it can be bounded. `code` holds every instruction by address; the
+       program starts at `entryPC` with `SC` at `entrySC`. */
+    public: static std::optional<uint_t> maximumDepth(
+        Code const&code, std::tuple<word_t, word_t> const&stack,
+        word_t const entryPC, word_t const entrySC
+    ) {
+        auto const[s0, s1]{stack};
+        if (entrySC < s0 || entrySC > s1 || (entrySC - s0) % 4 != 0)
+            return std::nullopt;
+
+        StackAnalysis analysis{code, s0, s1};
+        std::vector<word_t> order{};
+        std::set<word_t> finished{}, active{};
+        if (!analysis.walk(entryPC, true, order, finished, active))
+            return std::nullopt;
+        return analysis.bound(entryPC, entrySC - s0, order); }
+
+    private: StackAnalysis(
+        Code const&code, word_t const stackBegin, word_t const stackEnd
+    ) :
+        code{code},
+        stackBegin{stackBegin}, stackEnd{stackEnd},
+        functions{}, reached{}
+    { ; }
+
+    /* Analyzes the function at `entry` and, depth-first, its callees,
+       appending each function to `order` after all of its callees. */
+    private: bool walk(
+        word_t const entry, bool const isMain, std::vector<word_t> &order,
+        std::set<word_t> &finished, std::set<word_t> &active
+    ) {
+        if (Util::std20::contains(finished, entry))
+            return true;
+        /* recursion */
+        if (Util::std20::contains(active, entry))
+            return false;
+        active.insert(entry);
+
+        if (!analyze(entry, isMain))
+            return false;
+        for (auto const&[callee, _] : functions.at(entry).calls)
+            if (!walk(callee, false, order, finished, active))
+                return false;
+
+        active.erase(entry);
+        finished.insert(entry);
+        order.push_back(entry);
+        return true; }
+
+    private: bool analyze(word_t const entry, bool const isMain) {
+        Function &function{functions[entry]};
+        auto const access{[&](int64_t const at) {
+            function.lowest = std::min(function.lowest, at);
+            function.highest = std::max(function.highest, at+4); }};
+        /* a function's return address lies right below its entry */
+        auto const write{[&](int64_t const at) {
+            access(at);
+            function.lowestWrite = std::min(function.lowestWrite, at);
+            return isMain || at != -4; }};
+
+        std::vector<std::tuple<word_t, int64_t>> pending{{entry, 0}};
+        while (!pending.empty()) {
+            auto const[pc, sc]{pending.back()};
+            pending.pop_back();
+
+            auto const[it, inserted]{reached.try_emplace(pc, entry, sc)};
+            if (!inserted) {
+                if (it->second != std::make_tuple(entry, sc))
+                    return false;
+                continue; }
+
+            Instruction const*const instruction{code.find(pc)};
+            if (instruction == nullptr || pc > pc+5)
+                return false;
+            auto const[name, argument]{*instruction};
+            int64_t const offset{static_cast<int32_t>(argument)};
+            word_t const next{pc+5};
+
+            if (name == InstructionName::HLT)
+                continue;
+            if (name == InstructionName::SPC || name == InstructionName::SSC
+                || name == InstructionName::SIA)
+                return false;
+            if ((name == InstructionName::STA || name == InstructionName::STB)
+                && argument < stackEnd && argument+std::size_t{4} > stackBegin)
+                return false;
+            if (name == InstructionName::SYA
+                && argument < stackEnd && argument >= stackBegin)
+                return false;
+
+            if (name == InstructionName::RET) {
+                if (isMain || sc != 0)
+                    return false;
+                access(-4);
+                continue; }
+            if (name == InstructionName::CAL) {
+                if (!write(sc))
+                    return false;
+                function.calls.emplace_back(argument, sc);
+                pending.emplace_back(next, sc);
+                continue; }
+            if (name == InstructionName::PSH) {
+                if (!write(sc))
+                    return false;
+                pending.emplace_back(next, sc+4);
+                continue; }
+            if (name == InstructionName::POP) {
+                access(sc-4);
+                pending.emplace_back(next, sc-4);
+                continue; }
+            if (name == InstructionName::LSA || name == InstructionName::SSA) {
+                if (offset % 4 != 0)
+                    return false;
+                if (name == InstructionName::LSA)
+                    access(sc + offset);
+                else if (!write(sc + offset))
+                    return false;
+                pending.emplace_back(next, sc);
+                continue; }
+
+            if (name == InstructionName::JMP) {
+                pending.emplace_back(argument, sc);
+                continue; }
+            if (InstructionNameRepresentationHandler::doesPointAtInstruction(
+                name))
+                pending.emplace_back(argument, sc);
+            pending.emplace_back(next, sc);
+        }
+
+        return true; }
+
+    /* Propagates entry depths from callers to callees, `order` listing
+       every callee before its callers. */
+    private: std::optional<uint_t> bound(
+        word_t const main, int64_t const entryDepth,
+        std::vector<word_t> const&order
+    ) {
+        functions.at(main).minimumEntry = entryDepth;
+        functions.at(main).maximumEntry = entryDepth;
+
+        int64_t depth{entryDepth};
+        for (auto f{order.rbegin()}; f != order.rend(); ++f) {
+            Function const&function{functions.at(*f)};
+            if (function.minimumEntry + function.lowest < 0)
+                return std::nullopt;
+            depth = std::max(depth, function.maximumEntry + function.highest);
+
+            for (auto const&[callee, sc] : function.calls) {
+                Function &called{functions.at(callee)};
+                /* writes below a callee's return address have to stay
+                   within its caller's part of the stack */
+                if (sc + 4 + called.lowestWrite < 0)
+                    return std::nullopt;
+                called.minimumEntry = std::min(called.minimumEntry,
+                    function.minimumEntry + sc + 4);
+                called.maximumEntry = std::max(called.maximumEntry,
+                    function.maximumEntry + sc + 4);
+            }
+        }
+
+        return std::make_optional(static_cast<uint_t>(depth)); }
+};
+
+#endif
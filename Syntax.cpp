@@ -0,0 +1,241 @@
+#ifndef JOY_ASSEMBLER__SYNTAX_CPP
+#define JOY_ASSEMBLER__SYNTAX_CPP
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/* The assembly language's line grammar, recognized by hand. Every line is
+   normalized first (comments removed, whitespace collapsed) and then
+   tried against each line form in the order `Parser` lists them; each
+   form is matched exactly like the regular expression given above it
+   would under ECMAScript rules. The returned views point into the
+   normalized line. */
+namespace Syntax {
+
+    inline bool isSpace(char const c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f'
+            || c == '\r'; }
+    inline bool isAlpha(char const c) {
+        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'); }
+    inline bool isAlnum(char const c) {
+        return isAlpha(c) || ('0' <= c && c <= '9'); }
+
+    /* [[:alpha:]_][[:alnum:]_$-]* */
+    inline std::size_t identifierLength(std::string_view const s) {
+        if (s.empty() || !(isAlpha(s[0]) || s[0] == '_'))
+            return 0;
+        std::size_t n{1};
+        while (n < s.size() && (isAlnum(s[n])
+            || s[n] == '_' || s[n] == '$' || s[n] == '-'))
+            ++n;
+        return n; }
+
+    /* ['@[:alnum:]+-][^,]* */
+    inline bool isValue(std::string_view const s) {
+        return !s.empty() && (isAlnum(s[0]) || s[0] == '\'' || s[0] == '@'
+            || s[0] == '+' || s[0] == '-')
+            && s.find(',') == std::string_view::npos; }
+
+    /* "([^"]|\")*?" anchored at both ends, i.e. anything in quotes */
+    inline bool isString(std::string_view const s) {
+        return s.size() >= 2 && s.front() == '"' && s.back() == '"'; }
+
+    inline bool startsWith(std::string_view const s, std::string_view const p) {
+        return s.substr(0, p.size()) == p; }
+
+    /* Removes a comment, i.e. everything from the first `;` not preceded
+       by a backslash, collapses whitespace runs into a single space and
+       trims the line. As `.` does not match a carriage return, a comment
+       followed by one is kept. */
+    inline std::string normalize(std::string_view ln) {
+        std::size_t const cr{ln.rfind('\r')};
+        for (std::size_t p{0}; p < ln.size(); ++p)
+            if (ln[p] == ';' && (p == 0 || ln[p-1] != '\\')
+                && (cr == std::string_view::npos || cr < p)
+            ) {
+                ln = ln.substr(0, p);
+                break; }
+
+        std::string normalized{};
+        normalized.reserve(ln.size());
+        for (std::size_t p{0}; p < ln.size(); ) {
+            if (!isSpace(ln[p])) {
+                normalized.push_back(ln[p++]);
+                continue; }
+            while (p < ln.size() && isSpace(ln[p]))
+                ++p;
+            if (!normalized.empty() && p < ln.size())
+                normalized.push_back(' ');
+        }
+        return normalized; }
+
+    struct Definition { std::string_view name, value; };
+    /* ^(identifier) ?:= ?(value)$ */
+    inline std::optional<Definition> definition(std::string_view const ln) {
+        std::size_t const n{identifierLength(ln)};
+        if (n == 0)
+            return std::nullopt;
+        std::size_t p{n};
+        if (p < ln.size() && ln[p] == ' ')
+            ++p;
+        if (!startsWith(ln.substr(p), ":="))
+            return std::nullopt;
+        p += 2;
+        if (p < ln.size() && ln[p] == ' ')
+            ++p;
+        if (!isValue(ln.substr(p)))
+            return std::nullopt;
+        return std::make_optional(Definition{ln.substr(0, n), ln.substr(p)}); }
+
+    /* ^(identifier):$ */
+    inline std::optional<std::string_view> label(std::string_view const ln) {
+        std::size_t const n{identifierLength(ln)};
+        if (n == 0 || n+1 != ln.size() || ln[n] != ':')
+            return std::nullopt;
+        return std::make_optional(ln.substr(0, n)); }
+
+    /* ^data ?(.+)$ */
+    inline std::optional<std::string_view> data(std::string_view const ln) {
+        if (!startsWith(ln, "data"))
+            return std::nullopt;
+        std::size_t const p{ln.size() > 5 && ln[4] == ' ' ? 5u : 4u};
+        if (p >= ln.size())
+            return std::nullopt;
+        return std::make_optional(ln.substr(p)); }
+
+    struct DataElement {
+        std::string_view element, size, value;
+        /* the elements following this one, separated by commas */
+        std::string_view rest;
+    };
+    /* ^((\[(value)\])? ?(value|runif value|rperm)?|string) ?, ?(.*)$ */
+    inline std::optional<DataElement> dataElement(std::string_view const s) {
+        auto const afterComma{[&](std::size_t p) {
+            ++p;
+            if (p < s.size() && s[p] == ' ')
+                ++p;
+            return s.substr(p); }};
+
+        /*  ?(value)? ? up to the next comma; an element's value absorbs
+           trailing spaces */
+        auto const optionalValue{[](
+            std::string_view const t
+        ) -> std::optional<std::string_view> {
+            std::string_view const u{!t.empty() && t[0] == ' '
+                ? t.substr(1) : t};
+            if (isValue(u))
+                return std::make_optional(u);
+            if (u.empty() || u == " ")
+                return std::make_optional(std::string_view{});
+            return std::nullopt; }};
+
+        std::size_t const comma{s.find(',')};
+        if (comma != std::string_view::npos) {
+            std::string_view const e{s.substr(0, comma)};
+
+            /* the size's value is greedy, trying the last bracket first */
+            if (!e.empty() && e[0] == '[')
+                for (std::size_t q{e.size()}; q-- > 1; ) {
+                    if (e[q] != ']' || !isValue(e.substr(1, q-1)))
+                        continue;
+                    std::optional<std::string_view> const oValue{
+                        optionalValue(e.substr(q+1))};
+                    if (!oValue.has_value())
+                        continue;
+                    std::string_view const value{oValue.value()};
+                    std::size_t const end{value.empty()
+                        ? (e.size() > q+1 ? q+2 : q+1)
+                        : static_cast<std::size_t>(
+                            value.data() + value.size() - e.data())};
+                    return std::make_optional(DataElement{e.substr(0, end),
+                        e.substr(1, q-1), value, afterComma(comma)});
+                }
+
+            if (std::optional<std::string_view> const oValue{
+                optionalValue(e)}; oValue.has_value()
+            ) {
+                std::string_view const value{oValue.value()};
+                std::size_t const end{value.empty()
+                    ? (e.empty() ? 0 : 1)
+                    : static_cast<std::size_t>(
+                        value.data() + value.size() - e.data())};
+                return std::make_optional(DataElement{e.substr(0, end),
+                    std::string_view{}, value, afterComma(comma)});
+            }
+        }
+
+        /* a string ends at the first quote followed by a comma */
+        if (!s.empty() && s[0] == '"')
+            for (std::size_t q{1}; q < s.size(); ++q) {
+                if (s[q] != '"')
+                    continue;
+                std::size_t p{q+1};
+                if (p < s.size() && s[p] == ' ')
+                    ++p;
+                if (p < s.size() && s[p] == ',')
+                    return std::make_optional(DataElement{s.substr(0, q+1),
+                        std::string_view{}, std::string_view{},
+                        afterComma(p)});
+            }
+
+        return std::nullopt; }
+
+    /* ^runif (value)$ */
+    inline std::optional<std::string_view> runif(std::string_view const v) {
+        if (!startsWith(v, "runif ") || !isValue(v.substr(6)))
+            return std::nullopt;
+        return std::make_optional(v.substr(6)); }
+
+    /* ^include ?(string)$ */
+    inline std::optional<std::string_view> include(std::string_view const ln) {
+        if (!startsWith(ln, "include"))
+            return std::nullopt;
+        std::string_view s{ln.substr(7)};
+        if (!s.empty() && s[0] == ' ')
+            s = s.substr(1);
+        if (!isString(s))
+            return std::nullopt;
+        return std::make_optional(s); }
+
+    /* ^include.*$ */
+    inline bool improperInclude(std::string_view const ln) {
+        return startsWith(ln, "include"); }
+
+    struct ProfilerDirective { std::string_view startStop, message; };
+    /* ^profiler ([^ ]*?)(, ?(.*))?$ */
+    inline std::optional<ProfilerDirective> profiler(
+        std::string_view const ln
+    ) {
+        if (!startsWith(ln, "profiler "))
+            return std::nullopt;
+        std::string_view const s{ln.substr(9)};
+        std::size_t const k{std::min(s.find(','), s.size())};
+        if (s.substr(0, k).find(' ') != std::string_view::npos)
+            return std::nullopt;
+        std::string_view message{k < s.size() ? s.substr(k+1) : s.substr(k)};
+        if (!message.empty() && message[0] == ' ')
+            message = message.substr(1);
+        return std::make_optional(ProfilerDirective{s.substr(0, k), message}); }
+
+    struct InstructionLine {
+        std::string_view name;
+        std::optional<std::string_view> argument;
+    };
+    /* ^(identifier)( (value))?$ */
+    inline std::optional<InstructionLine> instruction(
+        std::string_view const ln
+    ) {
+        std::size_t const n{identifierLength(ln)};
+        if (n == 0)
+            return std::nullopt;
+        if (n == ln.size())
+            return std::make_optional(InstructionLine{ln, std::nullopt});
+        if (ln[n] != ' ' || !isValue(ln.substr(n+1)))
+            return std::nullopt;
+        return std::make_optional(InstructionLine{ln.substr(0, n),
+            std::make_optional(ln.substr(n+1))}); }
+}
+
+#endif
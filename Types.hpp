@@ -206,10 +206,126 @@ struct Instruction {
     }
 };
 
+/* Instructions decoded by the address they were fetched from. An address
+   holding none is marked by an op-code which names no instruction, such
+   that an entry takes no more room than the instruction itself. */
+class DecodedInstructions {
+    private:
+        static InstructionName constexpr none{
+            static_cast<InstructionName>(0xff)};
+        std::vector<Instruction> instructions;
+
+    public: DecodedInstructions() :
+        instructions{}
+    { ; }
+
+    public: std::size_t size() const {
+        return instructions.size(); }
+
+    public: void resize(std::size_t const n) {
+        instructions.resize(n, Instruction{none, 0}); }
+
+    public: Instruction const*find(uint_t const pc) const {
+        return pc < instructions.size() && instructions[pc].name != none
+            ? &instructions[pc] : nullptr; }
+
+    /* `pc` has to lie within `size` */
+    public: void store(uint_t const pc, Instruction const&instruction) {
+        instructions[pc] = instruction; }
+
+    public: void erase(uint_t const pc) {
+        if (pc < instructions.size())
+            instructions[pc] = Instruction{none, 0}; }
+};
+
+/* The runtime configuration of a computation's memory and I/O, lifted into
+   the type system such that each instantiation of the execution engines
+   only contains the checks it needs. */
+enum class MemoryBounds : uint8_t {
+    /* every access is compared against the memory size */
+    Fixed,
+    /* out-of-bounds accesses grow the memory */
+    Dynamic,
+    /* out-of-bounds accesses fault in hardware; see `Memory::guard` */
+    Guarded
+};
+
+/* `CheckStack` is only ever false for static programs whose stack depth
+   was proven to stay within the stack (see `StackAnalysis`) */
+template<
+    MemoryMode MemoryMode_, MemoryBounds Bounds, bool CheckSemantics,
+    bool CheckStack, bool Mock>
+struct MemoryPolicy {
+    static MemoryMode constexpr memoryMode{MemoryMode_};
+    static MemoryBounds constexpr bounds{Bounds};
+    static bool constexpr checkSemantics{CheckSemantics};
+    static bool constexpr checkStack{CheckStack};
+    static bool constexpr mock{Mock};
+};
+
+enum class ExecutionEngine : uint8_t { Switch, Threaded, Native };
+
+/* how the profiler reports: every region once the program stops, as a
+   table or as JSON, or every start and stop as it is hit */
+enum class ProfilerOutput : uint8_t { Table, JSON, Hits };
+
+enum class StopReason : uint8_t {
+    Halted, BudgetExhausted, Fault, ProfilerBoundary
+};
+
+/* where an assembled piece of memory came from: `count` bytes at
+   `address` stem from line `line` of file `files[file]` */
+struct SourceLine {
+    word_t address, count;
+    uint32_t file, line;
+    bool instruction;
+};
+struct SourceMap {
+    std::vector<std::filesystem::path> files{};
+    std::vector<SourceLine> lines{};
+    /* every label's address and name (without `@`), ordered by address */
+    std::vector<std::tuple<word_t, std::string>> labels{};
+
+    std::vector<word_t> instructionAddresses() const {
+        std::vector<word_t> addresses{};
+        for (SourceLine const&ln : lines)
+            if (ln.instruction)
+                addresses.push_back(ln.address);
+        return addresses;
+    }
+
+    /* the label at or nearest before `address`, with the distance from it
+       if any; the address itself if no label precedes it */
+    std::string symbolize(word_t const address) const {
+        auto const it{std::upper_bound(labels.begin(), labels.end(), address,
+            [](word_t const m, std::tuple<word_t, std::string> const&label) {
+                return m < std::get<0>(label); })};
+        std::ostringstream os{};
+        os << std::hex;
+        if (it == labels.begin())
+            os << "0x" << address;
+        else {
+            auto const&[m, name]{*std::prev(it)};
+            os << name;
+            if (address != m)
+                os << "+0x" << address - m; }
+        return os.str();
+    }
+};
+
 struct ComputationStateDebug {
     word_t highestUsedMemoryLocation{0};
     bool doWaitForUser{false}, doVisualizeSteps{false};
+    /* count executions per address; see `ComputationState::executions` */
+    bool doCountExecutions{false};
+    /* attribute executions to call paths; see `ComputationState::callGraph` */
+    bool doProfileCalls{false};
+    /* record conditional jumps; see `ComputationState::branchProfile` */
+    bool doProfileBranches{false};
+    ExecutionEngine engine{ExecutionEngine::Switch};
+    ProfilerOutput profilerOutput{ProfilerOutput::Table};
     std::optional<std::tuple<word_t, word_t>> stackBoundaries{std::nullopt};
+    SourceMap sourceMap{};
 };
 
 struct ComputationStateStatistics {
@@ -229,4 +345,30 @@ struct ComputationStateStatistics {
     }
 };
 
+/* what was executed between a profiler start and its stops, over every
+   time the region was passed */
+struct ProfilerRegion {
+    std::string name;
+    uint_t hits{0};
+    ComputationStateStatistics total{0, 0};
+    ComputationStateStatistics minimum{
+        std::numeric_limits<uint_t>::max(),
+        std::numeric_limits<uint_t>::max()};
+    ComputationStateStatistics maximum{0, 0};
+
+    void record(ComputationStateStatistics const&elapsed) {
+        ++hits;
+        total.nInstructions += elapsed.nInstructions;
+        total.nMicroInstructions += elapsed.nMicroInstructions;
+        minimum.nInstructions = std::min(minimum.nInstructions,
+            elapsed.nInstructions);
+        minimum.nMicroInstructions = std::min(minimum.nMicroInstructions,
+            elapsed.nMicroInstructions);
+        maximum.nInstructions = std::max(maximum.nInstructions,
+            elapsed.nInstructions);
+        maximum.nMicroInstructions = std::max(maximum.nMicroInstructions,
+            elapsed.nMicroInstructions);
+    }
+};
+
 #endif
@@ -13,6 +13,64 @@ std::function<void(bool const, std::string const&)> asserterFactory(
     };
 }
 
+/* what `ComputationState::memoryDump` writes */
+std::string memoryDump(ComputationState &cs) {
+    std::ostringstream dump{};
+    std::streambuf *const coutBuffer{std::cout.rdbuf(dump.rdbuf())};
+    cs.memoryDump();
+    std::cout.rdbuf(coutBuffer);
+    return dump.str();
+}
+
+/* the output of running a machine to its end, any fault and the final
+   memory dump; the first memory dump mocks any i/o */
+std::string finalMemoryDump(ComputationState &cs) {
+    memoryDump(cs);
+    std::ostringstream dump{};
+    std::streambuf *const coutBuffer{std::cout.rdbuf(dump.rdbuf())};
+    StopReason reason{StopReason::BudgetExhausted};
+    do reason = cs.run(std::numeric_limits<uint_t>::max());
+    while (reason == StopReason::BudgetExhausted);
+    if (reason == StopReason::Fault)
+        dump << cs.getFaultMessage() << "\n";
+    cs.memoryDump();
+    std::cout.rdbuf(coutBuffer);
+    return dump.str();
+}
+
+/* Parses `source` and runs it on each of `engines` until it halts, with
+   `prepare` called before and `check` after each run. By default `jit` is
+   left out, which falls back to `switch` while anything is observed. */
+void runOnEngines(
+    std::function<void(bool const, std::string const&)> const&asserter,
+    std::string const&source,
+    std::function<void(ComputationState &)> const&prepare,
+    std::function<void(ComputationState &)> const&check,
+    std::vector<ExecutionEngine> const&engines={
+        ExecutionEngine::Switch, ExecutionEngine::Threaded}
+) {
+    std::filesystem::path const filepath{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-engines.asm"};
+    std::ofstream{filepath} << source;
+    for (ExecutionEngine const engine : engines) {
+        std::optional<ComputationState> oCS{Parser{}.parse(filepath)};
+        asserter(oCS.has_value(), "test program not parsed:\n" + source);
+        if (!oCS.has_value())
+            break;
+        ComputationState &cs{oCS.value()};
+        cs.debug.engine = engine;
+        prepare(cs);
+        StopReason reason{StopReason::BudgetExhausted};
+        do reason = cs.run(std::numeric_limits<uint_t>::max());
+        while (reason == StopReason::ProfilerBoundary);
+        asserter(reason == StopReason::Halted,
+            "test program did not halt:\n" + source);
+        check(cs);
+    }
+    std::filesystem::remove(filepath);
+}
+
 bool unitTest_LevenshteinDistance() {
     bool testStatus{true};
     auto asserter{asserterFactory(testStatus)};
@@ -32,6 +90,20 @@ bool unitTest_LevenshteinDistance() {
         asserter(test(s, t, d), "incorrect Levenshtein distance on inputs '"
             + s + "' and '" + t + "'.");
 
+    asserter(!Util::LevenshteinDistanceAtMost("GUMBO", "GAMBOL", 1)
+        .has_value(), "bounded Levenshtein distance exceeds its bound");
+    asserter(Util::LevenshteinDistanceAtMost("GUMBO", "GAMBOL", 2)
+        == std::make_optional(uint_t{2}), "bounded Levenshtein distance "
+        "does not reach its bound");
+
+    std::vector<std::string> const labels{
+        "@loop", "@main", "@lop", "@end", "@loop2", "@stack", "@look"};
+    asserter(Util::closestByLevenshteinDistanceTo(labels, "@loop", 3)
+        == std::vector<std::string>{"@loop", "@look", "@loop2"},
+        "incorrect closest strings by Levenshtein distance");
+    asserter(Util::closestByLevenshteinDistanceTo(labels, "x", 0).empty(),
+        "closest strings by Levenshtein distance exceed their count");
+
     return testStatus;
 }
 
@@ -59,12 +131,869 @@ bool unitTest_Two_sComplement() {
     return testStatus;
 }
 
+bool unitTest_SemanticMap() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    Util::rng_t rng{};
+    std::vector<MemorySemantic> semantics{};
+    SemanticMap map{};
+    for (uint_t j{0}; j < 0x1ff; ++j) {
+        semantics.push_back(static_cast<MemorySemantic>(rng.unif(3)));
+        map.push_back(semantics.back()); }
+
+    asserter(map.size() == semantics.size(), "incorrect semantic map size");
+    for (std::size_t m{0}; m < semantics.size(); ++m)
+        asserter(map[m] == semantics[m],
+            "incorrect semantic at " + std::to_string(m));
+
+    std::array<std::size_t, 4> const order{0, 1, 2, 3};
+    auto const[mask, value]{
+        SemanticMap::pattern(wordMemorySemanticData, order)};
+    for (std::size_t m{0}; m+3 < semantics.size(); ++m) {
+        bool isData{true};
+        for (std::size_t j{0}; j < 4; ++j)
+            isData &= semantics[m+j] == wordMemorySemanticData[j];
+        asserter(((map.word(m) & mask) == value) == isData,
+            "incorrect word semantics at " + std::to_string(m)); }
+
+    return testStatus;
+}
+
+bool unitTest_MachineIO() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    MachineIO::MemorySource tape{
+        " 12\t-1\n0x10 0b101 +7 \xc3\xb6x 99999999999"};
+    for (word_t const n : {word_t{12}, word_t{0xffffffff}, word_t{16},
+        word_t{5}, word_t{7}})
+        asserter(tape.getNumber() == std::make_optional(n),
+            "incorrect number read from tape: " + std::to_string(n));
+    asserter(tape.getRune() == static_cast<UTF8::rune_t>(' '),
+        "tape does not keep separators as characters");
+    asserter(tape.getRune() == static_cast<UTF8::rune_t>(0xf6),
+        "incorrect multi-byte character read from tape");
+    asserter(tape.getRune() == static_cast<UTF8::rune_t>('x'),
+        "incorrect character read from tape");
+    bool malformed{false};
+    try { tape.getNumber(); }
+    catch (std::runtime_error const&) { malformed = true; }
+    asserter(malformed, "an out-of-range number was read from tape");
+
+    MachineIO::MemorySink sink{};
+    sink.putUnsigned(0xffffffff);
+    sink.putSigned(-0x80000000LL);
+    sink.putRune(0x2713);
+    asserter(sink.str() == "4294967295-2147483648\xe2\x9c\x93",
+        "incorrect output written to sink");
+
+    /* a machine's output can be redirected */
+    Parser parser{};
+    std::optional<ComputationState> oCS{parser.parse(
+        std::filesystem::current_path() / "test" / "programs"
+        / "test-003_hello.asm")};
+    asserter(oCS.has_value(), "could not parse test program");
+    if (oCS.has_value()) {
+        auto output{std::make_unique<MachineIO::MemorySink>()};
+        MachineIO::MemorySink const&out{*output};
+        oCS.value().setOutput(std::move(output));
+        asserter(oCS.value().run(std::numeric_limits<uint_t>::max())
+            == StopReason::Halted, "test program did not halt");
+        asserter(out.str().rfind("Hell\xc3\xb6, World!", 0) == 0,
+            "incorrect output redirected: " + out.str());
+    }
+
+    return testStatus;
+}
+
+bool unitTest_Syntax() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    std::vector<std::tuple<std::string, std::string>> const normalized{
+        {"  mov\t 5 ; comment", "mov 5"},
+        {"; comment", ""},
+        {"data \"a\\;b\";c", "data \"a\\;b\""},
+        {"ptc ; kept, since followed by\r", "ptc ; kept, since followed by"},
+    };
+    for (auto const&[ln, expected] : normalized)
+        asserter(Syntax::normalize(ln) == expected,
+            "incorrect normalization of line '" + ln + "'");
+
+    /* element, size, value */
+    std::vector<std::tuple<std::string, std::vector<std::tuple<
+        std::string, std::string, std::string>>>> const data{
+        {"[4]7, 8", {{"[4]7", "4", "7"}, {"8", "", "8"}}},
+        {"\"a, b\", [2] runif 9 ,", {{"\"a, b\"", "", ""},
+            {"[2] runif 9 ", "2", "runif 9 "}, {"", "", ""}}},
+        {"[1] 2]", {{"[1] 2]", "1] 2", ""}}},
+    };
+    for (auto const&[elements, expected] : data) {
+        std::string const commaSeparated{elements + ","};
+        std::string_view rest{commaSeparated};
+        for (auto const&[element, size, value] : expected) {
+            std::optional<Syntax::DataElement> const oElement{
+                Syntax::dataElement(rest)};
+            asserter(oElement.has_value()
+                && oElement.value().element == element
+                && oElement.value().size == size
+                && oElement.value().value == value,
+                "incorrect data element '" + element + "' in '"
+                    + elements + "'");
+            if (!oElement.has_value())
+                break;
+            rest = oElement.value().rest;
+        }
+        asserter(rest.empty(), "data elements left in '" + elements + "'");
+    }
+
+    asserter(Syntax::definition("x:= 'a'").has_value()
+        && !Syntax::definition("x := a, b").has_value(),
+        "incorrect definition syntax");
+    asserter(!Syntax::profiler("profiler start x").has_value()
+        && Syntax::profiler("profiler stop, msg, more").value().message
+            == "msg, more", "incorrect profiler syntax");
+    asserter(Syntax::data("database 5").value() == "base 5",
+        "incorrect data syntax");
+
+    /* the seed is reapplied after every definition, such that seeded
+       random data restarts its sequence after each label */
+    std::filesystem::path const seeded{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-seeded.asm"};
+    std::ofstream{seeded} << "pragma_rng-seed := 5\nhlt\n"
+        "a:\ndata [4] runif 1000\nb:\ndata [4] runif 1000\ndata 1\n";
+    std::optional<ComputationState> oCS{Parser{}.parse(seeded)};
+    asserter(oCS.has_value(), "could not parse seeded random data");
+    if (oCS.has_value()) {
+        /* each byte is dumped as two hex digits, separated by spaces;
+           trailing zeros are left out */
+        std::string const dump{memoryDump(oCS.value())};
+        std::string const bytes{dump.substr(dump.find("): ") + 3)};
+        asserter(bytes.size() >= 38*3 - 1 && bytes.substr(5*3, 16*3 - 1)
+            == bytes.substr(21*3, 16*3 - 1),
+            "seeded random data does not restart after a label: " + bytes);
+    }
+    std::filesystem::remove(seeded);
+
+    return testStatus;
+}
+
+bool unitTest_ExecutionEngines() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    /* no test program may read actual input */
+    std::istringstream noInput{};
+    std::streambuf *const cinBuffer{std::cin.rdbuf(noInput.rdbuf())};
+
+    auto const runDump{[](
+        std::filesystem::path const&filepath, ExecutionEngine const engine,
+        bool const guarded=false
+    ) {
+        std::optional<ComputationState> oCS{Parser{}.parse(filepath)};
+        if (!oCS.has_value())
+            return std::string{};
+        /* programs which cannot be guarded run unguarded */
+        if (guarded)
+            oCS.value().guardMemory();
+        oCS.value().debug.engine = engine;
+        return finalMemoryDump(oCS.value());
+    }};
+
+    std::set<std::filesystem::path> programs{};
+    for (auto const&entry : std::filesystem::directory_iterator{
+        std::filesystem::current_path() / "test" / "programs"})
+        programs.insert(entry.path());
+    asserter(!programs.empty(), "no test programs found");
+
+    for (std::filesystem::path const&program : programs) {
+        std::string const expected{runDump(
+            program, ExecutionEngine::Switch)};
+        for (ExecutionEngine const engine : {
+            ExecutionEngine::Threaded, ExecutionEngine::Native
+        })
+            asserter(runDump(program, engine) == expected,
+                "execution engines disagree on test program "
+                    + program.u8string());
+        for (ExecutionEngine const engine : {
+            ExecutionEngine::Switch, ExecutionEngine::Threaded,
+            ExecutionEngine::Native
+        })
+            asserter(runDump(program, engine, true) == expected,
+                "guarded memory changes the behaviour of test program "
+                    + program.u8string());
+    }
+
+    /* a static program accessing a word which would wrap around the top
+       of the address space */
+    std::filesystem::path const wrapping{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-wrapping.asm"};
+    std::ofstream{wrapping} << "mov 0xfffffffe\nswp\nlia 0\nhlt\n";
+    std::string const expected{runDump(
+        wrapping, ExecutionEngine::Switch)};
+    asserter(expected.find("invalid memory access") != std::string::npos,
+        "an access wrapping around memory was not reported: " + expected);
+    for (ExecutionEngine const engine : {
+        ExecutionEngine::Switch, ExecutionEngine::Threaded,
+        ExecutionEngine::Native
+    })
+        asserter(runDump(wrapping, engine, true) == expected,
+            "guarded memory changes the behaviour of an access wrapping "
+            "around memory");
+    std::filesystem::remove(wrapping);
+
+    /* a program overwriting the argument of an instruction it already
+       executed, which has to be decoded anew on its next fetch */
+    std::filesystem::path const modifying{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-modifying.asm"};
+    std::ofstream{modifying} << "pragma_static-program := false\nx:\n"
+        "mov 1\nptu\nlda @n\njz @end\ndec 1\nsta @n\nmov 7\nsta 1\njmp @x\n"
+        "end:\nhlt\nn:\ndata 1\n";
+    for (ExecutionEngine const engine : {
+        ExecutionEngine::Switch, ExecutionEngine::Threaded,
+        ExecutionEngine::Native
+    }) {
+        Parser parser{};
+        std::optional<ComputationState> oCS{parser.parse(modifying)};
+        asserter(oCS.has_value(), "could not parse a self-modifying program");
+        if (!oCS.has_value())
+            continue;
+        auto output{std::make_unique<MachineIO::MemorySink>()};
+        MachineIO::MemorySink const&out{*output};
+        oCS.value().setOutput(std::move(output));
+        oCS.value().debug.engine = engine;
+        oCS.value().run(std::numeric_limits<uint_t>::max());
+        asserter(out.str() == "17",
+            "an overwritten instruction was not decoded anew: " + out.str());
+    }
+    std::filesystem::remove(modifying);
+
+    /* a hot loop run with a large budget, such that compiled blocks do
+       most of the work, and a jump far outside of memory */
+    std::filesystem::path const jitted{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-jitted.asm"};
+    for (std::string const&program : {
+        std::string{"mov 100000\nloop:\nsta @n\nlda @x\ninc 3\nsta @x\n"
+            "lda @n\ndec 1\njnz @loop\nlda @x\nptu\nhlt\n"
+            "n:\ndata 0\nx:\ndata 0\n"},
+        std::string{"mov 0xfffffff0\nspc\nhlt\n"}
+    }) {
+        std::ofstream{jitted} << program;
+        std::string const switched{runDump(
+            jitted, ExecutionEngine::Switch)};
+        asserter(!switched.empty() && runDump(jitted,
+            ExecutionEngine::Native) == switched,
+            "the jit engine disagrees on program " + program);
+    }
+    std::filesystem::remove(jitted);
+
+    std::cin.rdbuf(cinBuffer);
+    return testStatus;
+}
+
+bool unitTest_ObjectFile() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    std::filesystem::path const objectFilepath{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test.joyo"};
+
+    for (auto const&entry : std::filesystem::directory_iterator{
+        std::filesystem::current_path() / "test" / "programs"}
+    ) {
+        std::string const program{entry.path().u8string()};
+        Parser parser{};
+        std::optional<ComputationState> oCS{parser.parse(entry.path())};
+        if (!oCS.has_value())
+            continue;
+
+        ObjectFile::write(objectFilepath, oCS.value());
+        ComputationState loaded{ObjectFile::load(objectFilepath)};
+        asserter(memoryDump(loaded) == memoryDump(oCS.value()),
+            "object file does not restore test program " + program);
+        asserter(loaded.debug.stackBoundaries
+            == oCS.value().debug.stackBoundaries,
+            "object file does not restore the stack of " + program);
+        asserter(loaded.debug.sourceMap.instructionAddresses()
+            == oCS.value().debug.sourceMap.instructionAddresses(),
+            "object file does not restore the source map of " + program);
+    }
+
+    /* an object file is verified before it runs, an instruction pointing
+       its constant data access at code being rejected */
+    std::filesystem::path const filepath{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-verifier.asm"};
+    std::ofstream{filepath} << "lda @x\nptu\nhlt\nx:\ndata 42\n";
+    for (bool const tamper : {false, true}) {
+        std::optional<ComputationState> oCS{Parser{}.parse(filepath)};
+        asserter(oCS.has_value(), "verifier test program not parsed");
+        if (!oCS.has_value())
+            break;
+        ObjectFile::write(objectFilepath, oCS.value());
+        if (tamper) {
+            std::ifstream is{objectFilepath, std::ios::binary};
+            std::string bytes{std::istreambuf_iterator<char>{is},
+                std::istreambuf_iterator<char>{}};
+            std::string const lda{"\x01\x0f\x00\x00\x00", 5};
+            std::size_t const at{bytes.find(lda)};
+            asserter(at != std::string::npos, "instruction not found");
+            if (at == std::string::npos)
+                break;
+            bytes[at+1] = '\x05';
+            std::ofstream{objectFilepath, std::ios::binary} << bytes; }
+
+        ComputationState loaded{ObjectFile::load(objectFilepath)};
+        auto sink{std::make_unique<MachineIO::MemorySink>()};
+        MachineIO::MemorySink const&output{*sink};
+        loaded.setOutput(std::move(sink));
+        std::ostringstream diagnostics{};
+        std::streambuf *const cerrBuffer{std::cerr.rdbuf(
+            diagnostics.rdbuf())};
+        StopReason const reason{loaded.run(100)};
+        std::cerr.rdbuf(cerrBuffer);
+        asserter(tamper ? reason == StopReason::Fault
+                && output.str().empty()
+            : reason == StopReason::Halted && output.str() == "42",
+            tamper ? "a statically invalid object file was run"
+                : "a verified object file did not run");
+        /* reported once, with the fault naming the invalid instruction */
+        std::string const report{diagnostics.str()};
+        asserter(!tamper || (report.find("ComputationState: instruction LDA")
+                == report.rfind("ComputationState: ")
+            && report.find("ComputationState: ") != std::string::npos
+            && loaded.getFaultMessage().rfind("instruction LDA", 0) == 0),
+            "an invalid object file was not reported precisely: " + report
+                + loaded.getFaultMessage());
+    }
+    std::filesystem::remove(filepath);
+
+    /* an invalid program being assembled is reported by the assembler
+       only, yet its fault is just as precise */
+    std::ofstream{filepath} << "lda @f\nhlt\nf:\nnop\n";
+    std::ostringstream diagnostics{};
+    std::streambuf *const cerrBuffer{std::cerr.rdbuf(diagnostics.rdbuf())};
+    std::optional<ComputationState> oInvalid{Parser{}.parse(filepath)};
+    StopReason const reason{oInvalid.has_value() ? oInvalid.value().run(100)
+        : StopReason::Fault};
+    std::cerr.rdbuf(cerrBuffer);
+    std::string const report{diagnostics.str()};
+    asserter(reason == StopReason::Fault
+        && report.find("instruction LDA") != std::string::npos
+        && report.find("instruction LDA") == report.rfind("instruction LDA")
+        && (!oInvalid.has_value() || oInvalid.value().getFaultMessage()
+            .rfind("instruction LDA", 0) == 0),
+        "an invalid program was not reported exactly once: " + report);
+    std::filesystem::remove(filepath);
+
+    /* a corrupt profiler directive's address is rejected rather than
+       sizing the machine's profiler after it */
+    std::ofstream{filepath} << "profiler start, corrupt\nhlt\n"
+        "profiler stop, corrupt\n";
+    for (bool const module : {false, true}) {
+        if (module) {
+            std::optional<Module> const oModule{Parser{}.compile(filepath)};
+            asserter(oModule.has_value(), "profiler test module not compiled");
+            if (!oModule.has_value())
+                break;
+            ObjectFile::write(objectFilepath, oModule.value()); }
+        else {
+            std::optional<ComputationState> const oCS{
+                Parser{}.parse(filepath)};
+            asserter(oCS.has_value(), "profiler test program not parsed");
+            if (!oCS.has_value())
+                break;
+            ObjectFile::write(objectFilepath, oCS.value()); }
+
+        std::ifstream is{objectFilepath, std::ios::binary};
+        std::string bytes{std::istreambuf_iterator<char>{is},
+            std::istreambuf_iterator<char>{}};
+        is.close();
+        /* a directive is its address, its kind and its message */
+        std::size_t const at{bytes.find(", ln 3: corrupt")};
+        asserter(at != std::string::npos && at >= 9,
+            "profiler directive not found");
+        if (at == std::string::npos || at < 9)
+            break;
+        std::size_t const address{bytes.rfind("file ", at) - 9};
+        bytes.replace(address, 4, "\xff\xff\xff\xff");
+        std::ofstream{objectFilepath, std::ios::binary} << bytes;
+
+        bool rejected{false};
+        try {
+            if (module)
+                ObjectFile::loadModule(objectFilepath);
+            else
+                ObjectFile::load(objectFilepath); }
+        catch (std::runtime_error const&) { rejected = true; }
+        asserter(rejected, "a corrupt profiler directive was loaded");
+    }
+    std::filesystem::remove(filepath);
+
+    std::ofstream{objectFilepath, std::ios::binary} << "JOYO";
+    bool truncated{false};
+    try { ObjectFile::load(objectFilepath); }
+    catch (std::runtime_error const&) { truncated = true; }
+    asserter(truncated, "a truncated object file was loaded");
+
+    std::filesystem::remove(objectFilepath);
+    return testStatus;
+}
+
+bool unitTest_Linker() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    auto const source{[](std::string const&name, std::string const&text) {
+        std::filesystem::path const filepath{
+            std::filesystem::temp_directory_path() / name};
+        std::ofstream{filepath} << text;
+        return filepath; }};
+
+    std::string const main{
+        "jmp @main\nvalue:\ndata 7\nmain:\nlda @value\npsh\ncal @twice\n"
+        "pop\nsta @value\nhlt\nstack:\ndata [16]\n"};
+    std::string const library{
+        "twice:\nlsa -8\nswp\nlsa -8\nadd\nssa -8\nret\n"};
+    std::vector<std::filesystem::path> const filepaths{
+        source("joy-assembler-unit-test-main.asm", main),
+        source("joy-assembler-unit-test-library.asm", library),
+        source("joy-assembler-unit-test-textual.asm", main
+            + "include \"joy-assembler-unit-test-library.asm\"\n")};
+
+    /* linking lays out modules as including them at the end would */
+    std::vector<Module> modules{};
+    for (std::size_t j{0}; j < 2; ++j)
+        if (std::optional<Module> oModule{Parser{}.compile(filepaths[j])};
+            oModule.has_value())
+            modules.push_back(std::move(oModule.value()));
+    asserter(modules.size() == 2, "could not compile modules");
+    if (modules.size() != 2)
+        return testStatus;
+    asserter(modules[0].relocations.size() == 4, "incorrect relocations");
+
+    std::optional<ComputationState> oLinked{Linker::link(modules)};
+    std::optional<ComputationState> oIncluded{Parser{}.parse(filepaths[2])};
+    asserter(oLinked.has_value(), "could not link modules");
+    asserter(oLinked.has_value() && oIncluded.has_value()
+        && finalMemoryDump(oLinked.value())
+            == finalMemoryDump(oIncluded.value()),
+        "linked modules differ from included source");
+
+    /* an import which no module exports */
+    std::streambuf *const cerrBuffer{std::cerr.rdbuf(nullptr)};
+    asserter(!Linker::link(std::vector<Module>{modules[0]}).has_value(),
+        "linked an unresolved import");
+    std::cerr.rdbuf(cerrBuffer);
+
+    for (std::filesystem::path const&filepath : filepaths)
+        std::filesystem::remove(filepath);
+    return testStatus;
+}
+
+bool unitTest_SourceCache() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    auto const initialMemoryDump{[](std::optional<ComputationState> &oCS) {
+        return oCS.has_value() ? memoryDump(oCS.value()) : std::string{}; }};
+
+    std::filesystem::path const cacheHome{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-cache"};
+    std::filesystem::remove_all(cacheHome);
+    char const*const xdg{std::getenv("XDG_CACHE_HOME")};
+    std::optional<std::string> const oXDG{xdg == nullptr ? std::nullopt
+        : std::make_optional(std::string{xdg})};
+    setenv("XDG_CACHE_HOME", cacheHome.c_str(), 1);
+
+    /* lexing anew, from the cache and from damaged cache entries */
+    for (auto const&entry : std::filesystem::directory_iterator{
+        std::filesystem::current_path() / "test" / "programs"}
+    ) {
+        std::string const program{entry.path().u8string()};
+        std::optional<ComputationState> oLexed{Parser{}.parse(entry.path())};
+        if (!oLexed.has_value())
+            continue;
+        std::optional<ComputationState> oCached{Parser{}.parse(entry.path())};
+        asserter(initialMemoryDump(oCached) == initialMemoryDump(oLexed),
+            "cached lexing differs for test program " + program);
+
+        for (auto const&cached : std::filesystem::directory_iterator{
+            cacheHome / "joy-assembler"})
+            std::filesystem::resize_file(cached.path(),
+                std::filesystem::file_size(cached.path()) / 2);
+        std::optional<ComputationState> oDamaged{Parser{}.parse(entry.path())};
+        asserter(initialMemoryDump(oDamaged) == initialMemoryDump(oLexed),
+            "damaged cache entry was used for test program " + program);
+    }
+    asserter(std::filesystem::exists(cacheHome / "joy-assembler"),
+        "nothing was cached");
+
+    /* an entry of other contents under a file's key, as if their hashes
+       collided */
+    std::filesystem::remove_all(cacheHome / "joy-assembler");
+    std::filesystem::path const colliding{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-colliding.asm"};
+    std::ofstream{colliding} << "mov 2\nptu\nhlt\n";
+    std::optional<ComputationState> oColliding{Parser{}.parse(colliding)};
+    std::string const expected{initialMemoryDump(oColliding)};
+    std::vector<std::filesystem::path> entries{};
+    for (auto const&cached : std::filesystem::directory_iterator{
+        cacheHome / "joy-assembler"})
+        entries.push_back(cached.path());
+    std::ofstream{colliding} << "mov 3\nptu\nhlt\n";
+    Parser{}.parse(colliding);
+    std::ofstream{colliding} << "mov 2\nptu\nhlt\n";
+    for (auto const&cached : std::filesystem::directory_iterator{
+        cacheHome / "joy-assembler"})
+        if (entries.size() == 1 && cached.path() != entries.front())
+            std::filesystem::copy_file(cached.path(), entries.front(),
+                std::filesystem::copy_options::overwrite_existing);
+    std::optional<ComputationState> oReparsed{Parser{}.parse(colliding)};
+    asserter(entries.size() == 1 && initialMemoryDump(oReparsed) == expected,
+        "a cache entry of other contents was used");
+
+    /* nothing is cached when opted out */
+    std::filesystem::remove_all(cacheHome / "joy-assembler");
+    setenv("JOY_ASSEMBLER_NO_CACHE", "1", 1);
+    Parser{}.parse(colliding);
+    asserter(!std::filesystem::exists(cacheHome / "joy-assembler"),
+        "a file was cached despite opting out");
+    unsetenv("JOY_ASSEMBLER_NO_CACHE");
+    std::filesystem::remove(colliding);
+
+    /* the least recently used entries are evicted beyond the capacity */
+    SourceCache const small{300};
+    for (char const c : {'a', 'b', 'c'})
+        small.store(std::string(100, c), LexedFile{});
+    uint_t total{0}, nEntries{0};
+    for (auto const&cached : std::filesystem::directory_iterator{
+        cacheHome / "joy-assembler"}) {
+        total += std::filesystem::file_size(cached.path());
+        ++nEntries; }
+    asserter(total <= 300 && nEntries == 2,
+        "the cache exceeds its capacity: " + std::to_string(total));
+
+    if (oXDG.has_value())
+        setenv("XDG_CACHE_HOME", oXDG.value().c_str(), 1);
+    else
+        unsetenv("XDG_CACHE_HOME");
+    std::filesystem::remove_all(cacheHome);
+    return testStatus;
+}
+
+bool unitTest_Optimizer() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    std::filesystem::path const filepath{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-optimizer.asm"};
+    std::ofstream{filepath}
+        << "mov 3\nsta @n\nloop:\nmov 5\ninc 1\ninc 2\ndec 1\nshl 1\nshl 2\n"
+           "nop\nnop\nsta @x\nsta @x\nptu\nlda @n\ndec 1\nsta @n\n"
+           "jnz @hop\nhlt\nhop:\njmp @skip\nskip:\nnop\njmp @loop\n"
+           "n:\ndata 0\nx:\ndata 0\n";
+
+    /* runs the program, returning its output and the optimizer's report */
+    auto const run{[](
+        std::filesystem::path const&filepath, bool const optimize
+    ) {
+        std::optional<ComputationState> oCS{Parser{}.parse(filepath)};
+        if (!oCS.has_value())
+            return std::make_tuple(std::string{}, std::string{});
+        auto sink{std::make_unique<MachineIO::MemorySink>()};
+        MachineIO::MemorySink const&output{*sink};
+        oCS.value().setOutput(std::move(sink));
+
+        std::ostringstream report{};
+        std::streambuf *const clogBuffer{std::clog.rdbuf(report.rdbuf())};
+        Optimizer optimizer{};
+        if (optimize)
+            optimizer.optimize(oCS.value());
+        optimizer.run(oCS.value());
+        std::clog.rdbuf(clogBuffer);
+        return std::make_tuple(output.str(), report.str()); }};
+
+    auto const[plainOutput, plainReport]{run(filepath, false)};
+    auto const[output, report]{run(filepath, true)};
+    asserter(plainOutput == "565656" && output == plainOutput,
+        "optimizing changed the program's output");
+    asserter(report.find("2 jumps threaded, 1 runs folded, 1 dead stores "
+        "removed") != std::string::npos, "unexpected rewrites: " + report);
+
+    /* the executed micro-instructions an unoptimized run reports */
+    std::string const executed{"dynamically ("};
+    std::size_t const p{plainReport.find(executed)};
+    std::string const unoptimized{p == std::string::npos ? std::string{}
+        : plainReport.substr(p + executed.size(),
+            plainReport.find(' ', p + executed.size()) - p - executed.size())};
+    asserter(!unoptimized.empty() && report.find("instead of " + unoptimized
+        + ")") != std::string::npos, "dynamic savings do not add up: "
+        + plainReport + report);
+
+    /* a return address computed at run time enters the run `mov 1; inc 2`
+       in its middle, which therefore may not be folded */
+    std::filesystem::path const computed{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-optimizer-ret.asm"};
+    std::ofstream{computed} << "mov @t\ninc 5\npsh\nret\nt:\nmov 1\ninc 2\n"
+        "ptu\nhlt\nstack:\ndata [4]\n";
+    asserter(std::get<0>(run(computed, false)) == "27"
+        && std::get<0>(run(computed, true)) == "27",
+        "optimizing changed where a computed return address leads");
+
+    std::filesystem::remove(computed);
+    std::filesystem::remove(filepath);
+    return testStatus;
+}
+
+bool unitTest_StackAnalysis() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    /* instructions laid out five bytes apart, starting at zero */
+    auto const depth{[](std::vector<Instruction> const&instructions) {
+        StackAnalysis::Code code{};
+        code.resize(5 * instructions.size());
+        for (std::size_t j{0}; j < instructions.size(); ++j)
+            code.store(5*j, instructions[j]);
+        return StackAnalysis::maximumDepth(code, {0x100, 0x200}, 0,
+            0x100); }};
+    using I = InstructionName;
+
+    /* main pushes an argument, f pushes and pops a word */
+    asserter(depth({{I::PSH, 0}, {I::CAL, 25}, {I::POP, 0}, {I::HLT, 0},
+            {I::HLT, 0}, {I::LSA, 0xfffffff8}, {I::PSH, 0}, {I::POP, 0},
+            {I::SSA, 0xfffffff8}, {I::RET, 0}})
+        == std::make_optional(uint_t{12}), "incorrect stack depth");
+    asserter(depth({{I::CAL, 10}, {I::HLT, 0}, {I::CAL, 10}, {I::RET, 0}})
+        == std::nullopt, "a recursive program's stack was bounded");
+    asserter(depth({{I::PSH, 0}, {I::JMP, 0}}) == std::nullopt,
+        "an unbalanced loop's stack was bounded");
+    asserter(depth({{I::CAL, 10}, {I::HLT, 0}, {I::SSA, 0xfffffffc},
+            {I::RET, 0}}) == std::nullopt,
+        "a program overwriting its return address had its stack bounded");
+    asserter(depth({{I::SSC, 0}, {I::PSH, 0}, {I::HLT, 0}}) == std::nullopt,
+        "a program setting SC had its stack bounded");
+    asserter(depth({{I::POP, 0}, {I::HLT, 0}}) == std::nullopt,
+        "an underflowing program had its stack bounded");
+
+    /* a bound exceeding the declared stack is warned about, and the
+       program fails just as it would without the analysis */
+    std::filesystem::path const filepath{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-test-stack.asm"};
+    std::ofstream{filepath} << "psh\ncal @f\nhlt\nf:\npsh\npop\nret\n"
+        "stack:\ndata [2]\n";
+    std::ostringstream diagnostics{};
+    std::streambuf *const cerrBuffer{std::cerr.rdbuf(diagnostics.rdbuf())};
+    std::optional<ComputationState> oCS{Parser{}.parse(filepath)};
+    std::cerr.rdbuf(cerrBuffer);
+    asserter(diagnostics.str().find("the stack may grow to 12 bytes")
+        != std::string::npos, "missing stack warning: " + diagnostics.str());
+    asserter(oCS.has_value() && oCS.value().run(100) == StopReason::Fault
+        && oCS.value().getFaultMessage()
+            == "storeMemory4Stack: stack overflow",
+        "an overflowing stack was not reported");
+
+    std::filesystem::remove(filepath);
+    return testStatus;
+}
+
+bool unitTest_Hotspots() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    runOnEngines(asserter, "mov 10\nloop:\n  dec 1\n  jnz @loop\nhlt\n",
+        [](ComputationState &cs) { cs.debug.doCountExecutions = true; },
+        [&](ComputationState &cs) {
+            std::map<word_t, ComputationStateStatistics> const executions{
+                cs.executions()};
+            uint_t nInstructions{0}, nMicroInstructions{0};
+            for (auto const&[pc, statistics] : executions) {
+                nInstructions += statistics.nInstructions;
+                nMicroInstructions += statistics.nMicroInstructions; }
+            asserter(executions.size() == 4
+                && executions.at(5).nInstructions == 10
+                && nInstructions == cs.getStatistics().nInstructions
+                && nMicroInstructions
+                    == cs.getStatistics().nMicroInstructions,
+                "executions do not add up to the machine's statistics");
+
+            std::ostringstream report{};
+            Hotspots::report(report, cs, 1);
+            asserter(report.str().find(":4  jnz @loop\n") != std::string::npos
+                && report.str().find("(3 more addresses)")
+                    != std::string::npos,
+                "unexpected hotspot report: " + report.str()); });
+
+    return testStatus;
+}
+
+bool unitTest_CallGraph() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    runOnEngines(asserter, "cal @twice\nhlt\ntwice:\ncal @once\n"
+        "cal @once\nret\nonce:\ninc\nret\nstack:\ndata [4]\n",
+        [](ComputationState &cs) { cs.debug.doProfileCalls = true; },
+        [&](ComputationState &cs) {
+            std::vector<CallGraph::Frame> const&frames{
+                cs.callGraph().getFrames()};
+            uint_t nInstructions{0}, nMicroInstructions{0};
+            for (CallGraph::Frame const&frame : frames) {
+                nInstructions += frame.self.nInstructions;
+                nMicroInstructions += frame.self.nMicroInstructions; }
+            asserter(frames.size() == 3 && frames[2].calls == 2
+                && nInstructions == cs.getStatistics().nInstructions
+                && nMicroInstructions
+                    == cs.getStatistics().nMicroInstructions,
+                "call paths do not add up to the machine's statistics");
+
+            std::ostringstream folded{};
+            cs.callGraph().writeFolded(folded, cs.debug.sourceMap);
+            asserter(folded.str().find("\n0x0;twice 31\n0x0;twice;once 20\n")
+                != std::string::npos,
+                "unexpected folded stacks: " + folded.str());
+            asserter(cs.debug.sourceMap.symbolize(26) == "once+0x1"
+                && cs.debug.sourceMap.symbolize(0) == "0x0",
+                "addresses are named incorrectly"); });
+
+    return testStatus;
+}
+
+bool unitTest_ProfilerRegions() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    /* profiler regions observe nothing, such that `jit` runs them */
+    runOnEngines(asserter, "mov 3\nloop:\nprofiler start, body\ndec\n"
+        "jz @done\nprofiler stop, body\njmp @loop\ndone:\nnop\n"
+        "profiler stop, last body\nhlt\n",
+        [](ComputationState &) { ; },
+        [&](ComputationState &cs) {
+            std::vector<ProfilerRegion> const&regions{
+                cs.getProfilerRegions()};
+            asserter(regions.size() == 1 && regions[0].hits == 3
+                && regions[0].minimum.nInstructions == 2
+                && regions[0].maximum.nInstructions == 3
+                && regions[0].total.nInstructions == 7,
+                "profiler regions were not aggregated");
+
+            std::ostringstream json{};
+            ProfilerSummary::json(json, regions);
+            asserter(json.str().find("\"hits\": 3, \"instructions\": "
+                "{\"min\": 2, \"mean\": 2.3, \"max\": 3, \"total\": 7}")
+                != std::string::npos,
+                "unexpected profiler summary: " + json.str()); },
+        {ExecutionEngine::Switch, ExecutionEngine::Threaded,
+            ExecutionEngine::Native});
+
+    return testStatus;
+}
+
+bool unitTest_CacheModel() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    /* a 32x32 word matrix traversed by rows touches each line once, while
+       traversing it by columns maps every row onto the same few sets */
+    CacheModel::Configuration configuration{};
+    configuration.memoryLatency = 10;
+    CacheModel byRows{configuration}, byColumns{configuration};
+    for (word_t r{0}; r < 32; ++r)
+        for (word_t c{0}; c < 32; ++c) {
+            byRows.execute(0, Instruction{InstructionName::LDA,
+                r*128 + c*4}, 0, 0);
+            byColumns.execute(0, Instruction{InstructionName::LDA,
+                c*128 + r*4}, 0, 0); }
+    asserter(byRows.getDataCache().misses == 256
+        && byColumns.getDataCache().misses == 1024
+        && byRows.getCycles() + 768*10 == byColumns.getCycles(),
+        "cache misses were not modeled correctly");
+
+    runOnEngines(asserter, "cal @f\nlda @x\nhlt\nf:\npsh\npop\nret\n"
+        "x:\ndata 42\nstack:\ndata [4]\n",
+        [&](ComputationState &cs) { cs.modelCaches(configuration); },
+        [&](ComputationState &cs) {
+            CacheModel const&model{cs.cacheModel().value()};
+            CacheModel::Cache const&ic{model.getInstructionCache()};
+            CacheModel::Cache const&dc{model.getDataCache()};
+            /* five data accesses, the one to @x straddling two lines */
+            asserter(dc.hits + dc.misses == 6
+                && ic.hits + ic.misses >= cs.getStatistics().nInstructions
+                && model.getCycles() == cs.getStatistics().nMicroInstructions
+                    + 10 * (ic.misses + dc.misses),
+                "modeled cycles do not add up"); });
+
+    return testStatus;
+}
+
+bool unitTest_BranchProfile() {
+    bool testStatus{true};
+    auto asserter{asserterFactory(testStatus)};
+
+    /* `jne @odd` alternates, defeating a 1-bit predictor entirely and a
+       2-bit one half of the time */
+    runOnEngines(asserter, "mov 100\nloop:\njne @odd\ndec\njnz @loop\n"
+        "hlt\nodd:\ndec\njnz @loop\nhlt\n",
+        [](ComputationState &cs) { cs.debug.doProfileBranches = true; },
+        [&](ComputationState &cs) {
+            std::map<word_t, BranchProfile::Site> const sites{
+                cs.branchProfile().getSites()};
+            asserter(sites.size() == 3 && sites.at(5).executed == 100
+                && sites.at(5).taken == 50 && sites.at(5).oneBitCorrect == 1
+                && sites.at(5).twoBitCorrect == 50
+                && sites.at(15).executed == 50 && sites.at(15).taken == 50,
+                "branch outcomes were not recorded correctly");
+
+            std::ostringstream report{};
+            cs.branchProfile().report(report, cs.debug.sourceMap, 1);
+            asserter(report.str().find("50.00%    1.00%   50.00%  ")
+                    != std::string::npos
+                && report.str().find(":3  jne @odd\n") != std::string::npos
+                && report.str().find("(2 more sites)") != std::string::npos,
+                "unexpected branch report: " + report.str()); });
+
+    return testStatus;
+}
+
 int main() {
+    /* parsing caches lexed files (see `SourceCache`), which is to leave
+       the actual cache untouched */
+    std::filesystem::path const cacheHome{
+        std::filesystem::temp_directory_path()
+        / "joy-assembler-unit-tests-cache"};
+    setenv("XDG_CACHE_HOME", cacheHome.c_str(), 1);
+
     #define NameTheIdentifier(IDENTIFIER) \
         std::make_tuple(std::string{#IDENTIFIER}, IDENTIFIER)
     auto const&unitTests{std::vector{
         NameTheIdentifier(unitTest_LevenshteinDistance),
         NameTheIdentifier(unitTest_Two_sComplement),
+        NameTheIdentifier(unitTest_SemanticMap),
+        NameTheIdentifier(unitTest_MachineIO),
+        NameTheIdentifier(unitTest_Syntax),
+        NameTheIdentifier(unitTest_ExecutionEngines),
+        NameTheIdentifier(unitTest_ObjectFile),
+        NameTheIdentifier(unitTest_Linker),
+        NameTheIdentifier(unitTest_SourceCache),
+        NameTheIdentifier(unitTest_Optimizer),
+        NameTheIdentifier(unitTest_StackAnalysis),
+        NameTheIdentifier(unitTest_Hotspots),
+        NameTheIdentifier(unitTest_CallGraph),
+        NameTheIdentifier(unitTest_ProfilerRegions),
+        NameTheIdentifier(unitTest_CacheModel),
+        NameTheIdentifier(unitTest_BranchProfile),
     }};
     #undef NameTheIdentifier
 
@@ -72,6 +1001,7 @@ int main() {
         if (!unitTest()) {
             std::cerr << "\33[38;5;124m[ERR]\33[0m at least one unit test "
                 "failed: " << unitTestName << std::endl;
+            std::filesystem::remove_all(cacheHome);
             return EXIT_FAILURE; }
         else
             std::clog << "\33[38;5;154m[SUC]\33[0m unit test passed: "
@@ -79,6 +1009,7 @@ int main() {
 
     std::clog << "\33[38;5;154m[SUC]\33[0m every unit test succeeded ("
               << unitTests.size() << " in total)" << std::endl;
+    std::filesystem::remove_all(cacheHome);
 
     return EXIT_SUCCESS;
 }
@@ -1,14 +1,19 @@
 #ifndef JOY_ASSEMBLER__UTIL_CPP
 #define JOY_ASSEMBLER__UTIL_CPP
 
+#include <charconv>
 #include <chrono>
+#include <cstring>
+#include <numeric>
 #include <random>
+#include <string_view>
 #include <thread>
 
 #include <iostream>
 #include <optional>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "Types.hpp"
 #include "UTF8.cpp"
@@ -23,6 +28,12 @@ namespace Util {
             return map.count(key) != 0;
         }
 
+        /* a custom std::unordered_map::contains (C++20) implementation */
+        template<typename K, typename V>
+        inline bool contains(std::unordered_map<K, V> const&map, K const&key) {
+            return map.count(key) != 0;
+        }
+
         /* a custom std::set::contains (C++20) implementation */
         template<typename V>
         inline constexpr bool contains(std::set<V> const&set, V const&value) {
@@ -38,6 +49,20 @@ namespace Util {
         return false;
     }
 
+    /* a custom `std::endian::native == std::endian::little` (C++20) */
+    inline bool hostIsLittleEndian() {
+        uint32_t const one{1};
+        uint8_t first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    /* a custom std::byteswap (C++23) implementation */
+    inline constexpr uint32_t byteSwap(uint32_t const w) {
+        return (w >> 24) | ((w >> 8) & 0x0000ff00)
+            | ((w << 8) & 0x00ff0000) | (w << 24);
+    }
+
     namespace ANSI_COLORS {
         auto esc{[](std::string const&code) {
 #ifdef NO_ANSI_COLORS
@@ -234,52 +259,53 @@ namespace Util {
         return std::make_optional(unescaped);
     }
 
-    std::optional<word_t> stringToOptionalUInt32(std::string const&s) {
-        static_assert(sizeof (int64_t) == sizeof (long long int));
-        static_assert(sizeof (long long int) > sizeof (word_t));
-
-        std::optional<long long int> oN{std::nullopt};
-
-        std::vector<std::tuple<std::string,
-        std::function<std::string(std::string const&)>, int>> const actions{
-            {"^\\s*([+-]?0[xX][0-9a-fA-F]+)\\s*$",
-                [](std::string const&str) { return str; }, 16},
-            {"^\\s*([+-]?[0-9]+)\\s*$",
-                [](std::string const&str) { return str; }, 10},
-            {"^\\s*([+-]?0[bB][01]+)\\s*$", [](std::string const&str) {
-                return std::string{std::regex_replace(
-                    str, std::regex{"0[bB]"}, "")}; }, 2},
-        };
-
-        for (auto const&[regexString, lambda, base] : actions)
-            if (!oN.has_value()) {
-                std::smatch smatch{};
-                if (std::regex_match(s, smatch, std::regex{regexString})) {
-                    try {
-                        oN = std::make_optional(std::stoll(lambda(
-                            std::string{smatch[1]}), nullptr, base));
-                    } catch (std::invalid_argument const&_) {
-                        oN = std::nullopt;
-                    }
-                }
-            }
-
-        long long int constexpr min32s{-(1LL << 31)}, max32s{(1LL << 31)-1};
-        long long int constexpr min32u{0x0000'0000}, max32u{0xffff'ffff};
-        static_assert(std::numeric_limits<int32_t>::min() == min32s);
-        static_assert(std::numeric_limits<int32_t>::max() == max32s);
-        static_assert(std::numeric_limits<uint32_t>::min() == min32u);
-        static_assert(std::numeric_limits<uint32_t>::max() == max32u);
-
-        if (oN.has_value() && min32u <= oN.value() && oN.value() <= max32u)
-            return std::make_optional(static_cast<uint32_t>(oN.value()));
-        if (oN.has_value() && min32s <= oN.value() && oN.value() <= max32s)
-            return std::make_optional(toTwo_sComplement<int32_t, uint32_t, 32>(
-                static_cast<int32_t>(oN.value())));
+    /* Parses an optionally signed decimal, hexadecimal (`0x`) or binary
+       (`0b`) number surrounded by optional whitespace. Values outside of
+       both the unsigned and the signed 32-bit range are rejected; negative
+       values are returned in two's complement. */
+    std::optional<word_t> charsToOptionalUInt32(
+        char const*p, char const*end
+    ) {
+        auto const isSpace{[](char const c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\v'
+                || c == '\f' || c == '\r'; }};
+        while (p != end && isSpace(*p))
+            ++p;
+        while (p != end && isSpace(end[-1]))
+            --end;
+
+        bool negative{false};
+        if (p != end && (*p == '+' || *p == '-'))
+            negative = *p++ == '-';
+
+        int base{10};
+        if (end-p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+            base = 16;
+        else if (end-p > 2 && p[0] == '0' && (p[1] == 'b' || p[1] == 'B'))
+            base = 2;
+        if (base != 10)
+            p += 2;
+
+        /* `std::from_chars` would accept a second sign */
+        if (p == end || *p == '-')
+            return std::nullopt;
+        uint64_t n{0};
+        auto const[q, ec]{std::from_chars(p, end, n, base)};
+        if (ec != std::errc{} || q != end)
+            return std::nullopt;
 
+        if (!negative || n == 0)
+            return n <= 0xffff'ffff
+                ? std::make_optional(static_cast<word_t>(n)) : std::nullopt;
+        if (n <= uint64_t{1} << 31)
+            return std::make_optional(static_cast<word_t>(
+                (uint64_t{1} << 32) - n));
         return std::nullopt;
     }
 
+    std::optional<word_t> stringToOptionalUInt32(std::string const&s) {
+        return charsToOptionalUInt32(s.data(), s.data() + s.size()); }
+
     std::string UInt32AsPaddedHex(uint32_t const n) {
         char buf[9];
         std::snprintf(buf, 9, "%08x", n);
@@ -311,53 +337,128 @@ namespace Util {
         return str;
     }
 
-    uint_t LevenshteinDistance(std::string const&s, std::string const&t) {
+    /* right-aligned to `n` characters, as in report columns */
+    std::string pad(std::string const&s, std::size_t const n) {
+        return std::string(s.size() < n ? n - s.size() : 0, ' ') + s; }
+
+    /* `part` of `total` as a percentage rounded to two decimal places */
+    std::string percent(uint_t const part, uint_t const total) {
+        uint_t const basisPoints{total == 0 ? 0 : (part * 10000 + total/2)
+            / total};
+        std::string const fraction{std::to_string(basisPoints % 100)};
+        return std::to_string(basisPoints / 100) + "."
+            + std::string(2 - fraction.size(), '0') + fraction + "%"; }
+
+    /* The Levenshtein distance between `s` and `t` if it is at most
+       `bound`; computed row by row, giving up as soon as a whole row
+       exceeds the bound. */
+    std::optional<uint_t> LevenshteinDistanceAtMost(
+        std::string_view const s, std::string_view const t, uint_t const bound
+    ) {
         /* see "https://people.cs.pitt.edu/~kirk/cs1501/Pruhs/Fall2006/
             Assignments/editdistance/Levenshtein%20Distance.htm" */
-        std::size_t n{s.size()}, m{t.size()};
-        if (n <= 0 || m <= 0)
-            return std::max(n, m);
-
-        std::vector<std::vector<uint_t>> d(m+1,
-            std::vector<uint_t>(n+1, uint_t{0}));
-        for (std::size_t r{0}; r <= n; ++r)
-            d[0][r] = r;
-        for (std::size_t c{0}; c <= m; ++c)
-            d[c][0] = c;
+        std::size_t const n{s.size()}, m{t.size()};
+        if ((n > m ? n - m : m - n) > bound)
+            return std::nullopt;
 
+        std::vector<uint_t> previous(n+1), current(n+1);
+        std::iota(previous.begin(), previous.end(), uint_t{0});
         for (std::size_t j{1}; j <= m; ++j) {
+            current[0] = static_cast<uint_t>(j);
+            uint_t rowMinimum{current[0]};
             for (std::size_t i{1}; i <= n; ++i) {
-                uint_t cost{s[i-1] == t[j-1] ? uint_t{0} : uint_t{1}};
-                d[j][i] = std::min(std::min(
-                    d[j][i-1] + 1,
-                    d[j-1][i] + 1),
-                    d[j-1][i-1] + cost
+                uint_t const cost{s[i-1] == t[j-1] ? uint_t{0} : uint_t{1}};
+                current[i] = std::min(std::min(
+                    current[i-1] + 1,
+                    previous[i] + 1),
+                    previous[i-1] + cost
                 );
+                rowMinimum = std::min(rowMinimum, current[i]);
             }
+            if (rowMinimum > bound)
+                return std::nullopt;
+            std::swap(previous, current);
         }
 
-        return d[m][n];
+        if (previous[n] > bound)
+            return std::nullopt;
+        return std::make_optional(previous[n]);
     }
 
-    std::vector<std::string> sortByLevenshteinDistanceTo(
-        std::vector<std::string> const&v, std::string const&r
+    uint_t LevenshteinDistance(std::string const&s, std::string const&t) {
+        return LevenshteinDistanceAtMost(s, t,
+            std::numeric_limits<uint_t>::max()).value(); }
+
+    /* The (at most) `k` strings of `v` closest to `r`, nearest first and
+       ties broken alphabetically. Once `k` candidates are known, every
+       further distance is only computed up to the worst of them. */
+    std::vector<std::string> closestByLevenshteinDistanceTo(
+        std::vector<std::string> const&v, std::string const&r,
+        std::size_t const k
     ) {
-        std::vector<std::string> w{v};
-        std::sort(w.begin(), w.end(), [r](auto s, auto t) {
-            return LevenshteinDistance(r, s) <= LevenshteinDistance(r, t); });
+        std::vector<std::tuple<uint_t, std::string>> closest{};
+        if (k == 0)
+            return std::vector<std::string>{};
+        closest.reserve(k+1);
+        for (std::string const&s : v) {
+            uint_t const bound{closest.size() < k
+                ? std::numeric_limits<uint_t>::max()
+                : std::get<0>(closest.back())};
+            std::optional<uint_t> const oD{
+                LevenshteinDistanceAtMost(r, s, bound)};
+            if (!oD.has_value())
+                continue;
+            std::tuple<uint_t, std::string> candidate{oD.value(), s};
+            if (closest.size() == k && !(candidate < closest.back()))
+                continue;
+            closest.insert(std::upper_bound(closest.begin(), closest.end(),
+                candidate), std::move(candidate));
+            if (closest.size() > k)
+                closest.pop_back();
+        }
+
+        std::vector<std::string> w{};
+        for (auto &[_, s] : closest)
+            w.push_back(std::move(s));
         return w;
     }
 
     class rng_t {
         private:
             std::mt19937 rng;
+            bool seeded;
 
         public: rng_t() :
-            rng{std::random_device{}()}
+            rng{std::random_device{}()},
+            seeded{false}
         {}
 
         public: void seed(word_t const seed) {
             rng.seed(seed);
+            seeded = true;
+        }
+
+        /* whether the engine is reproducible, i.e. was explicitly seeded */
+        public: bool isSeeded() const {
+            return seeded;
+        }
+
+        /* the engine's state in its standard textual representation */
+        public: std::string state() const {
+            std::ostringstream os{};
+            os << rng;
+            return os.str();
+        }
+
+        /* resumes from a `state()`; fails on a malformed state */
+        public: bool restore(std::string const&state) {
+            std::istringstream is{state};
+            std::mt19937 restored{};
+            if (!(is >> restored))
+                return false;
+            rng = restored;
+            seeded = true;
+            return true;
         }
 
         public: word_t unif(word_t const n) {
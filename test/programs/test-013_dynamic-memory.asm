@@ -0,0 +1,35 @@
+pragma_memory-size := dynamic
+pragma_static-program := false
+
+; dynamic memory grows on demand; addresses are computed to sidestep the
+; static bounds analysis
+
+; a word straddling a page boundary
+mov 0x2ffe
+swp
+mov 0xdeadbeef
+sia
+
+; reading beyond the memory's end grows it with zeros
+mov 0x2000
+swp
+lia 0x0ff0
+swp
+mov 0x2ffe
+swp
+lia
+add
+swp
+mov 0x0800
+swp
+sia
+
+; a word written within a single page
+mov 0x1001
+swp
+mov 0x5a
+sia 4
+lia 4
+inc 1
+sia 8
+hlt
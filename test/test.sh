@@ -8,7 +8,13 @@ pristineHashes="$root/pristine-hashes"
 programs="$root/programs"
 mkdir -p "$pristineHashes" "$programs"
 
+# lexed files are cached (see SourceCache.cpp); leave the actual cache be
+XDG_CACHE_HOME="$(mktemp -d)" || exit 1
+export XDG_CACHE_HOME
+
 tmp="$root/.tmp.dmp"
+translated="$root/.tmp.cpp"
+translatedBinary="$root/.tmp.out"
 
 find "$root/programs" -mindepth 1 -maxdepth 1 -type f | sort | \
 while read prg; do
@@ -20,19 +26,43 @@ while read prg; do
     [ ! -f "$pristineMemoryDumpHash" ] \
         && printf '    \33[38;5;124m[ERR]\33[0m could not find pristine ' \
         && printf 'memory dump hash\n' && exit 1
-    printf '    executing: %s ...\n' "$prg"
-    "$root/../JoyAssembler" "$prg" memory-dump | sha512sum > "$tmp"
-    printf '    comparing to pristine memory dump hash\n'
-    ! cmp 2>/dev/null "$pristineMemoryDumpHash" "$tmp" \
-        && printf '        \33[38;5;124m[ERR]\33[0m memory dump hash ' \
-        && printf 'mismatch\n      Please note that tests named "test-r-"* ' \
-        && printf 'may perform platform-dependend.\n      To recalibrate all ' \
-        && printf 'pristine hashes, ' \
-        && printf '\33[3mfundamentally altering all tests\33[0m, you may run ' \
-        && printf '\n          %% ./test/.superb.sh\n' && exit 1
-
-    printf '        \33[38;5;154m[SUC]\33[0m memory dump hash match\n'
-done || exit 1
-
-rm "$tmp"
+    for engine in switch threaded jit; do
+        printf '    executing (%s engine): %s ...\n' "$engine" "$prg"
+        "$root/../JoyAssembler" "$prg" memory-dump "$engine" \
+            | sha512sum > "$tmp"
+        printf '    comparing to pristine memory dump hash\n'
+        ! cmp 2>/dev/null "$pristineMemoryDumpHash" "$tmp" \
+            && printf '        \33[38;5;124m[ERR]\33[0m memory dump hash ' \
+            && printf 'mismatch\n      Please note that tests named "test-r-"* ' \
+            && printf 'may perform platform-dependend.\n      To recalibrate all ' \
+            && printf 'pristine hashes, ' \
+            && printf '\33[3mfundamentally altering all tests\33[0m, you may run ' \
+            && printf '\n          %% ./test/.superb.sh\n' && exit 1
+
+        printf '        \33[38;5;154m[SUC]\33[0m memory dump hash match\n'
+    done || exit 1
+
+    # memory dumps step one instruction at a time, which leaves compiled
+    # blocks unused; run once more with an unbounded budget
+    printf '    executing (jit engine, unbounded): %s ...\n' "$prg"
+    "$root/../JoyAssembler" "$prg" switch < /dev/null > "$tmp" 2>&1
+    "$root/../JoyAssembler" "$prg" jit < /dev/null 2>&1 \
+        | cmp -s "$tmp" - \
+        || { printf '        \33[38;5;124m[ERR]\33[0m the jit engine ' \
+            && printf 'disagrees with the switch engine\n' && exit 1; }
+    printf '        \33[38;5;154m[SUC]\33[0m jit output match\n'
+
+    # the program translated into C++ has to behave as interpreted
+    printf '    translating into C++: %s ...\n' "$prg"
+    "$root/../JoyAssembler" "$prg" emit-cpp > "$translated" \
+        && c++ -std=c++17 -O1 "$translated" -o "$translatedBinary" \
+        || { printf '        \33[38;5;124m[ERR]\33[0m could not translate ' \
+            && printf 'or compile\n' && exit 1; }
+    "$translatedBinary" < /dev/null 2>&1 | cmp -s "$tmp" - \
+        || { printf '        \33[38;5;124m[ERR]\33[0m the translated ' \
+            && printf 'program disagrees with the switch engine\n' && exit 1; }
+    printf '        \33[38;5;154m[SUC]\33[0m translated output match\n'
+done || { rm -rf "$XDG_CACHE_HOME"; exit 1; }
+
+rm -r "$tmp" "$translated" "$translatedBinary" "$XDG_CACHE_HOME"
 printf '\n\33[38;5;154m[SUC]\33[0m every test has passed\n' && exit 0